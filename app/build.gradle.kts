@@ -67,6 +67,11 @@ android {
         jvmTarget = "1.8"
     }
 
+    androidResources {
+        // Las mallas .hmesh y las texturas .ktx2 se mapean directamente desde el APK: no deben comprimirse
+        noCompress += listOf("hmesh", "ktx2")
+    }
+
     packaging {
         resources {
             pickFirsts += "**/libc++_shared.so"
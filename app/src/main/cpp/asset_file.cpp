@@ -0,0 +1,79 @@
+#include "asset_file.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "native_log.h"
+
+bool MappedAsset::open(AAssetManager* assetManager, const char* path) {
+    close();
+
+    if (!assetManager) {
+        LOGE("AAssetManager no disponible para abrir %s", path);
+        return false;
+    }
+
+    AAsset* openedAsset = AAssetManager_open(assetManager, path, AASSET_MODE_RANDOM);
+    if (!openedAsset) {
+        LOGD("Asset no encontrado: %s", path);
+        return false;
+    }
+
+    // Ruta rápida: asset sin comprimir -> mmap directo sobre el APK
+    off_t start = 0;
+    off_t length = 0;
+    int fd = AAsset_openFileDescriptor(openedAsset, &start, &length);
+    if (fd >= 0) {
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        const off_t mapOffset = start & ~static_cast<off_t>(pageSize - 1);
+        const size_t delta = static_cast<size_t>(start - mapOffset);
+
+        void* base = mmap(nullptr, length + delta, PROT_READ, MAP_PRIVATE, fd, mapOffset);
+        ::close(fd); // El mapeo mantiene su propia referencia al archivo
+
+        if (base != MAP_FAILED) {
+            AAsset_close(openedAsset);
+            mapBase = base;
+            mapLength = length + delta;
+            data = static_cast<const uint8_t*>(base) + delta;
+            size = static_cast<size_t>(length);
+            return true;
+        }
+        LOGE("mmap falló para %s, usando buffer del asset", path);
+    }
+
+    // Fallback: asset comprimido, el AAssetManager lo descomprime una vez
+    const void* buffer = AAsset_getBuffer(openedAsset);
+    if (!buffer) {
+        LOGE("No se pudo obtener el buffer del asset %s", path);
+        AAsset_close(openedAsset);
+        return false;
+    }
+
+    asset = openedAsset;
+    data = static_cast<const uint8_t*>(buffer);
+    size = static_cast<size_t>(AAsset_getLength(openedAsset));
+    LOGD("Asset %s comprimido en el APK; considerar noCompress", path);
+    return true;
+}
+
+void MappedAsset::prefetch() const {
+    if (mapBase) {
+        madvise(mapBase, mapLength, MADV_WILLNEED);
+    }
+    // En el fallback el AAssetManager ya descomprimió el asset en memoria
+}
+
+void MappedAsset::close() {
+    if (mapBase) {
+        munmap(mapBase, mapLength);
+        mapBase = nullptr;
+        mapLength = 0;
+    }
+    if (asset) {
+        AAsset_close(asset);
+        asset = nullptr;
+    }
+    data = nullptr;
+    size = 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <android/asset_manager.h>
+#include <cstddef>
+#include <cstdint>
+
+// Asset del APK mapeado en memoria de solo lectura.
+// Si el asset se empaquetó sin comprimir se mapea con mmap sobre el descriptor
+// del propio APK (AAsset_openFileDescriptor); si no, se usa el buffer del AAsset.
+struct MappedAsset {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    void* mapBase = nullptr;   // Inicio del mmap (alineado a página)
+    size_t mapLength = 0;
+    AAsset* asset = nullptr;   // Solo en el fallback sin mmap
+
+    bool open(AAssetManager* assetManager, const char* path);
+    void close();
+
+    // Pide al kernel que lea las páginas del mapeo por adelantado (MADV_WILLNEED)
+    void prefetch() const;
+
+    ~MappedAsset() { close(); }
+};
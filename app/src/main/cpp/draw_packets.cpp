@@ -0,0 +1,242 @@
+#include "draw_packets.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#include "frame_arena.h"
+#include "gl_state_cache.h"
+#include "job_system.h"
+#include "native_log.h"
+#include "thread_registry.h"
+
+namespace {
+
+// Elementos mínimos por stream: por debajo el coste de repartir supera al de grabar
+constexpr uint32_t kRecordGrain = 64;
+constexpr uint32_t kStreamsPerThread = 4;
+
+GLsizeiptr alignUp(GLsizeiptr value, GLint alignment) {
+    return (value + alignment - 1) & ~static_cast<GLsizeiptr>(alignment - 1);
+}
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+UniformAllocation DrawStream::allocateUniforms(GLsizeiptr size) {
+    UniformAllocation allocation;
+    const GLsizeiptr aligned = alignUp(size, uniformAlignment);
+    if (!uniforms.data || uniformCursor + aligned > uniforms.size) {
+        return allocation;
+    }
+    allocation.offset = uniforms.offset + uniformCursor;
+    allocation.size = size;
+    allocation.data = static_cast<uint8_t*>(uniforms.data) + uniformCursor;
+    uniformCursor += aligned;
+    return allocation;
+}
+
+bool DrawStream::push(const DrawPacket& packet) {
+    if (count >= capacity) {
+        dropped++;
+        return false;
+    }
+    packets[count++] = packet;
+    return true;
+}
+
+uint32_t DrawPacketRecorder::record(JobSystem& jobs, LinearArena& arena, UniformRing* uniformRing, uint32_t itemCount,
+                                    uint32_t packetsPerItem, GLsizeiptr uniformBytesPerItem, const RecordFunction& body) {
+    sorted = nullptr;
+    sortedCount = 0;
+    if (itemCount == 0) {
+        return 0;
+    }
+    const auto recordStart = std::chrono::steady_clock::now();
+
+    const uint32_t maxStreams = jobs.concurrency() * kStreamsPerThread;
+    const uint32_t chunkSize = std::max(kRecordGrain, (itemCount + maxStreams - 1) / maxStreams);
+    const uint32_t streamCount = (itemCount + chunkSize - 1) / chunkSize;
+    const GLint alignment = uniformRing ? uniformRing->offsetAlignment : 16;
+
+    // Memoria de todos los streams reservada aquí, en el hilo GL: los workers no asignan
+    DrawStream* streams = arena.allocateArray<DrawStream>(streamCount);
+    for (uint32_t i = 0; i < streamCount; i++) {
+        DrawStream& stream = *new (&streams[i]) DrawStream();
+        const uint32_t items = std::min(chunkSize, itemCount - i * chunkSize);
+        stream.capacity = items * packetsPerItem;
+        stream.packets = arena.allocateArray<DrawPacket>(stream.capacity);
+        stream.uniformAlignment = alignment;
+        if (uniformBytesPerItem > 0) {
+            const GLsizeiptr blockSize = alignUp(uniformBytesPerItem, alignment) * stream.capacity;
+            if (uniformRing) {
+                stream.uniforms = uniformRing->allocate(blockSize);
+            } else {
+                stream.uniforms.size = blockSize;
+                stream.uniforms.data = arena.allocate(static_cast<size_t>(blockSize), static_cast<size_t>(alignment));
+            }
+        }
+    }
+
+    // Cada stream se graba en su worker
+    auto recordStream = [&](uint32_t index) {
+        DrawStream& stream = streams[index];
+        const uint32_t begin = index * chunkSize;
+        body(stream, begin, std::min(itemCount, begin + chunkSize));
+    };
+    if (streamCount == 1) {
+        recordStream(0);
+    } else {
+        JobCounter counter;
+        for (uint32_t i = 1; i < streamCount; i++) {
+            jobs.run(counter, [&recordStream, i]() { recordStream(i); });
+        }
+        recordStream(0);
+        jobs.wait(counter);
+    }
+    const double recordMs = msSince(recordStart);
+
+    const auto sortStart = std::chrono::steady_clock::now();
+    sort(arena, streams, streamCount);
+    const double sortMs = msSince(sortStart);
+
+    uint32_t dropped = 0;
+    for (uint32_t i = 0; i < streamCount; i++) {
+        dropped += streams[i].dropped;
+    }
+    if (dropped > 0) {
+        LOGE("%u paquetes de draw descartados por falta de espacio", dropped);
+    }
+
+    stats.frames++;
+    stats.streams = streamCount;
+    const double weight = 1.0 / static_cast<double>(std::min<uint64_t>(stats.frames, 120));
+    stats.recordMs += (recordMs - stats.recordMs) * weight;
+    stats.sortMs += (sortMs - stats.sortMs) * weight;
+    return sortedCount;
+}
+
+void DrawPacketRecorder::sort(LinearArena& arena, const DrawStream* streams, uint32_t streamCount) {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < streamCount; i++) {
+        total += streams[i].count;
+    }
+    if (total == 0) {
+        return;
+    }
+
+    // Se ordenan claves de 16 bytes en lugar de paquetes de 32 y los paquetes se
+    // copian una sola vez, ya en orden, para que el replay los lea secuencialmente
+    RenderQueueEntry* entries = arena.allocateArray<RenderQueueEntry>(total);
+    RenderQueueEntry* scratch = arena.allocateArray<RenderQueueEntry>(total);
+    const DrawPacket** sources = arena.allocateArray<const DrawPacket*>(total);
+    uint32_t cursor = 0;
+    for (uint32_t i = 0; i < streamCount; i++) {
+        for (uint32_t p = 0; p < streams[i].count; p++) {
+            entries[cursor].key = streams[i].packets[p].sortKey;
+            entries[cursor].index = cursor;
+            sources[cursor] = &streams[i].packets[p];
+            cursor++;
+        }
+    }
+    const RenderQueueEntry* queue = radixSortRenderQueue(entries, scratch, total);
+
+    DrawPacket* output = arena.allocateArray<DrawPacket>(total);
+    for (uint32_t i = 0; i < total; i++) {
+        output[i] = *sources[queue[i].index];
+    }
+    sorted = output;
+    sortedCount = total;
+}
+
+void DrawPacketRecorder::replay(GlStateCache& state, GLuint uniformBuffer, GLuint drawBinding) {
+    for (uint32_t i = 0; i < sortedCount; i++) {
+        const DrawPacket& packet = sorted[i];
+        state.useProgram(packet.program);
+        state.bindVertexArray(packet.vao);
+        if (packet.uniformSize > 0) {
+            state.bindBufferRange(GL_UNIFORM_BUFFER, drawBinding, uniformBuffer, packet.uniformOffset, packet.uniformSize);
+        }
+
+        if (packet.indexType != GL_NONE) {
+            glDrawElements(packet.mode, static_cast<GLsizei>(packet.count), packet.indexType, nullptr);
+        } else {
+            glDrawArrays(packet.mode, 0, static_cast<GLsizei>(packet.count));
+        }
+    }
+    stats.packets += sortedCount;
+}
+
+void DrawPacketRecorder::logStats() const {
+    LOGI("Draw packets: %llu emitidos, %u streams, grabar %.3f ms, ordenar %.3f ms",
+         (unsigned long long)stats.packets, stats.streams, stats.recordMs, stats.sortMs);
+}
+
+void runDrawPacketBenchmark() {
+    constexpr uint32_t kItems = 20000;
+    constexpr uint32_t kRuns = 5;
+    constexpr uint32_t kPrograms = 8;
+    constexpr uint32_t kVaos = 64;
+
+    const CpuTopology topology = queryCpuTopology();
+    const uint32_t maxThreads = std::max(topology.coreCount(), 1u);
+    LOGI("=== Benchmark de draw packets: %u draws, 1..%u hilos ===", kItems, maxThreads);
+
+    // Grabación representativa: matriz de modelo y color por draw, clave por programa, malla y profundidad
+    auto body = [](DrawStream& stream, uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            UniformAllocation uniforms = stream.allocateUniforms(sizeof(DrawUniforms));
+            if (!uniforms.data) {
+                stream.dropped++;
+                continue;
+            }
+            DrawUniforms drawData;
+            const float offset = static_cast<float>(i % 100) * 0.1f;
+            drawData.model = mat4Translation(offset, 0.0f, -offset);
+            drawData.color[0] = drawData.color[1] = drawData.color[2] = drawData.color[3] = 1.0f;
+            memcpy(uniforms.data, &drawData, sizeof(DrawUniforms));
+
+            DrawPacket packet;
+            packet.program = 1 + (i * 7) % kPrograms;
+            packet.vao = 1 + (i * 13) % kVaos;
+            packet.uniformOffset = static_cast<uint32_t>(uniforms.offset);
+            packet.uniformSize = sizeof(DrawUniforms);
+            packet.count = 36;
+            packet.indexType = GL_UNSIGNED_SHORT;
+            packet.sortKey = makeRenderKey(kRenderLayerOpaque, packet.program, packet.vao, 0.5f + offset);
+            stream.push(packet);
+        }
+    };
+
+    LinearArena arena;
+    arena.initialize(kItems * (sizeof(DrawPacket) * 4 + 256) + 64 * 1024);
+    double singleThreadMs = 0.0;
+    for (uint32_t threads = 1; threads <= maxThreads; threads++) {
+        JobSystem jobs;
+        jobs.start(threads - 1);
+        DrawPacketRecorder recorder;
+
+        double bestMs = 0.0;
+        for (uint32_t run = 0; run <= kRuns; run++) {
+            arena.reset();
+            const auto start = std::chrono::steady_clock::now();
+            recorder.record(jobs, arena, nullptr, kItems, 1, sizeof(DrawUniforms), body);
+            const double ms = msSince(start);
+            // La primera pasada calienta cachés y arranca los workers
+            if (run == 1 || (run > 1 && ms < bestMs)) {
+                bestMs = ms;
+            }
+        }
+        if (threads == 1) {
+            singleThreadMs = bestMs;
+        }
+        const double speedup = bestMs > 0.0 ? singleThreadMs / bestMs : 0.0;
+        LOGI("  %u hilos: %.3f ms (%u streams), aceleración x%.2f", threads, bestMs, recorder.stats.streams, speedup);
+        jobs.stop();
+    }
+    arena.destroy();
+}
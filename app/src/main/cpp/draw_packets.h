@@ -0,0 +1,83 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <cstdint>
+#include <functional>
+
+#include "render_queue.h"
+#include "uniform_ring.h"
+
+struct GlStateCache;
+struct JobSystem;
+struct LinearArena;
+
+// Draw autocontenido de tamaño fijo: programa, VAO, rango del bloque DrawData en
+// el UBO y parámetros del draw. Los workers los graban sin tocar GL y el hilo GL
+// los reproduce en orden de sortKey.
+struct DrawPacket {
+    uint64_t sortKey = 0;            // makeRenderKey()
+    GLuint program = 0;
+    GLuint vao = 0;
+    uint32_t uniformOffset = 0;      // Offset del bloque DrawData dentro del buffer
+    uint32_t uniformSize = 0;        // 0: no cambia el bloque DrawData
+    uint32_t count = 0;              // Índices o vértices
+    uint16_t indexType = GL_NONE;    // GL_NONE: glDrawArrays
+    uint16_t mode = GL_TRIANGLES;
+};
+static_assert(sizeof(DrawPacket) == 32, "DrawPacket debe ocupar media línea de caché");
+
+// Stream de un worker: paquetes y un bloque del UBO propios, sin sincronización
+struct DrawStream {
+    DrawPacket* packets = nullptr;
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+    uint32_t dropped = 0;            // Paquetes o bloques DrawData que no cupieron
+
+    UniformAllocation uniforms;      // Bloque del anillo reservado para este stream
+    GLsizeiptr uniformCursor = 0;
+    GLint uniformAlignment = 256;
+
+    // Datos por draw dentro del bloque del stream; data == nullptr si no cabe
+    UniformAllocation allocateUniforms(GLsizeiptr size);
+    bool push(const DrawPacket& packet);
+};
+
+struct DrawPacketStats {
+    uint64_t packets = 0;
+    uint32_t streams = 0;            // Del último frame
+    double recordMs = 0.0;           // Grabación en los workers, media móvil
+    double sortMs = 0.0;             // Cola de render en el hilo GL, media móvil
+    uint64_t frames = 0;
+};
+
+// Graba draws en paralelo (un stream por trozo), los ordena en el hilo GL con la
+// cola de render (radix sort de sortKey) y los reproduce en ese orden a través de
+// la caché de estado GL, que filtra los cambios redundantes. La memoria sale del
+// arena del frame.
+struct DrawPacketRecorder {
+    using RecordFunction = std::function<void(DrawStream& stream, uint32_t begin, uint32_t end)>;
+
+    DrawPacketStats stats;
+
+    // Sin uniformRing los bloques DrawData salen del arena (benchmarks sin GL).
+    // Devuelve el número de paquetes grabados.
+    uint32_t record(JobSystem& jobs, LinearArena& arena, UniformRing* uniformRing, uint32_t itemCount,
+                    uint32_t packetsPerItem, GLsizeiptr uniformBytesPerItem, const RecordFunction& body);
+
+    const DrawPacket* packets() const { return sorted; }
+    uint32_t packetCount() const { return sortedCount; }
+
+    // Hilo GL: el bloque ViewData ya debe estar enlazado
+    void replay(GlStateCache& state, GLuint uniformBuffer, GLuint drawBinding);
+
+    void logStats() const;
+
+private:
+    void sort(LinearArena& arena, const DrawStream* streams, uint32_t streamCount);
+
+    const DrawPacket* sorted = nullptr;
+    uint32_t sortedCount = 0;
+};
+
+// Grabación y orden de N draws con 1..N hilos en el host (solo logs)
+void runDrawPacketBenchmark();
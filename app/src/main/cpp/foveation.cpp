@@ -0,0 +1,150 @@
+#include "foveation.h"
+
+#include <algorithm>
+
+#include "native_log.h"
+#include "xr_check.h"
+#include "xr_dispatch.h"
+
+namespace {
+
+const char* const kModeNames[kFoveationModeCount] = {"desactivada", "fija", "eye-tracked"};
+
+} // namespace
+
+bool FoveationController::initialize(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId,
+                                     XrSession xrSession) {
+    createFoveationProfile = dispatch.xrCreateFoveationProfileFB;
+    destroyFoveationProfile = dispatch.xrDestroyFoveationProfileFB;
+    getEyeTrackedState = dispatch.xrGetFoveationEyeTrackedStateMETA;
+    if (!createFoveationProfile || !destroyFoveationProfile || !dispatch.xrUpdateSwapchainFB) {
+        LOGI("Foveation no disponible (faltan XR_FB_foveation / XR_FB_swapchain_update_state)");
+        return false;
+    }
+    updateSwapchain = dispatch.xrUpdateSwapchainFB;
+    session = xrSession;
+
+    eyeTrackedSupported = false;
+    if (getEyeTrackedState) {
+        XrSystemFoveationEyeTrackedPropertiesMETA eyeTrackedProperties{XR_TYPE_SYSTEM_FOVEATION_EYE_TRACKED_PROPERTIES_META};
+        XrSystemProperties systemProperties{XR_TYPE_SYSTEM_PROPERTIES};
+        systemProperties.next = &eyeTrackedProperties;
+        if (XR_SUCCEEDED(xrGetSystemProperties(instance, systemId, &systemProperties))) {
+            eyeTrackedSupported = eyeTrackedProperties.supportsFoveationEyeTracked == XR_TRUE;
+        }
+    }
+    eyeTrackedFailed = false;
+    activeMode = kFoveationOff;
+
+    LOGI("✓ Foveation disponible (eye-tracked: %s)", eyeTrackedSupported ? "sí" : "no");
+    return true;
+}
+
+void FoveationController::destroy() {
+    for (auto& profile : profiles) {
+        if (profile != XR_NULL_HANDLE && destroyFoveationProfile) {
+            destroyFoveationProfile(profile);
+        }
+        profile = XR_NULL_HANDLE;
+    }
+    createFoveationProfile = nullptr;
+    destroyFoveationProfile = nullptr;
+    updateSwapchain = nullptr;
+    getEyeTrackedState = nullptr;
+    session = XR_NULL_HANDLE;
+    activeMode = kFoveationOff;
+    centerValid = false;
+}
+
+void FoveationController::setMode(FoveationMode mode) {
+    requestedMode = mode;
+    if (mode == kFoveationEyeTracked) {
+        eyeTrackedFailed = false;
+    }
+}
+
+XrFoveationProfileFB FoveationController::profileFor(FoveationMode mode) {
+    if (profiles[mode] != XR_NULL_HANDLE) {
+        return profiles[mode];
+    }
+
+    XrFoveationLevelProfileCreateInfoFB levelInfo{XR_TYPE_FOVEATION_LEVEL_PROFILE_CREATE_INFO_FB};
+    levelInfo.level = mode == kFoveationOff ? XR_FOVEATION_LEVEL_NONE_FB : level;
+    levelInfo.verticalOffset = 0.0f;
+    levelInfo.dynamic = XR_FOVEATION_DYNAMIC_DISABLED_FB;
+
+    // El perfil eye-tracked es un perfil de nivel con la estructura META encadenada
+    XrFoveationEyeTrackedProfileCreateInfoMETA eyeTrackedInfo{XR_TYPE_FOVEATION_EYE_TRACKED_PROFILE_CREATE_INFO_META};
+    if (mode == kFoveationEyeTracked) {
+        levelInfo.next = &eyeTrackedInfo;
+    }
+
+    XrFoveationProfileCreateInfoFB createInfo{XR_TYPE_FOVEATION_PROFILE_CREATE_INFO_FB};
+    createInfo.next = &levelInfo;
+
+    XrResult result = createFoveationProfile(session, &createInfo, &profiles[mode]);
+    if (XR_FAILED(result)) {
+        LOGE("No se pudo crear el perfil de foveation %s: %d", kModeNames[mode], result);
+        profiles[mode] = XR_NULL_HANDLE;
+    }
+    return profiles[mode];
+}
+
+bool FoveationController::apply(FoveationMode mode, const std::vector<XrSwapchain>& swapchains) {
+    XrFoveationProfileFB profile = profileFor(mode);
+    if (profile == XR_NULL_HANDLE) {
+        return false;
+    }
+
+    XrSwapchainStateFoveationFB foveationState{XR_TYPE_SWAPCHAIN_STATE_FOVEATION_FB};
+    foveationState.profile = profile;
+    for (XrSwapchain swapchain : swapchains) {
+        if (!CheckXrResult(updateSwapchain(swapchain, reinterpret_cast<XrSwapchainStateBaseHeaderFB*>(&foveationState)),
+                           "xrUpdateSwapchainFB")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FoveationController::update(const std::vector<XrSwapchain>& swapchains) {
+    if (!isAvailable()) {
+        return;
+    }
+
+    FoveationMode targetMode = requestedMode;
+    if (targetMode == kFoveationEyeTracked && (!eyeTrackedSupported || eyeTrackedFailed)) {
+        targetMode = kFoveationFixed;
+    }
+
+    if (targetMode != activeMode) {
+        if (apply(targetMode, swapchains)) {
+            LOGI("Foveation %s", kModeNames[targetMode]);
+            activeMode = targetMode;
+        } else if (targetMode == kFoveationEyeTracked) {
+            // Sin permiso de eye tracking el perfil no se crea: quedarse con foveation fija
+            LOGI("Foveation eye-tracked no disponible, usando foveation fija");
+            eyeTrackedFailed = true;
+            if (apply(kFoveationFixed, swapchains)) {
+                activeMode = kFoveationFixed;
+            }
+        }
+    }
+
+    centerValid = false;
+    if (activeMode == kFoveationEyeTracked && getEyeTrackedState) {
+        XrFoveationEyeTrackedStateMETA eyeTrackedState{XR_TYPE_FOVEATION_EYE_TRACKED_STATE_META};
+        if (XR_SUCCEEDED(getEyeTrackedState(session, &eyeTrackedState)) &&
+            (eyeTrackedState.flags & XR_FOVEATION_EYE_TRACKED_STATE_VALID_BIT_META)) {
+            center[0] = eyeTrackedState.foveationCenter[0];
+            center[1] = eyeTrackedState.foveationCenter[1];
+            centerValid = true;
+        }
+    }
+}
+
+void FoveationController::recordGpuTime(FoveationMode mode, double gpuMs) {
+    FoveationGpuStats& stats = gpuStats[mode];
+    stats.samples++;
+    stats.averageMs += (gpuMs - stats.averageMs) / static_cast<double>(std::min<uint64_t>(stats.samples, 120));
+}
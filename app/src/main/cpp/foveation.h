@@ -0,0 +1,61 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cstdint>
+#include <vector>
+
+struct XrDispatch;
+
+enum FoveationMode : uint32_t {
+    kFoveationOff = 0,
+    kFoveationFixed = 1,
+    kFoveationEyeTracked = 2,
+    kFoveationModeCount = 3
+};
+
+// Tiempo de GPU medio por modo de foveation (media móvil en ms)
+struct FoveationGpuStats {
+    double averageMs = 0.0;
+    uint64_t samples = 0;
+};
+
+// Foveation de los swapchains con XR_FB_foveation. El modo eye-tracked usa
+// XR_META_foveation_eye_tracked; si el sistema no lo soporta o el permiso de
+// eye tracking está denegado, se usa foveation fija.
+struct FoveationController {
+    PFN_xrCreateFoveationProfileFB createFoveationProfile = nullptr;
+    PFN_xrDestroyFoveationProfileFB destroyFoveationProfile = nullptr;
+    PFN_xrUpdateSwapchainFB updateSwapchain = nullptr;
+    PFN_xrGetFoveationEyeTrackedStateMETA getEyeTrackedState = nullptr;
+
+    XrSession session = XR_NULL_HANDLE;
+    XrFoveationProfileFB profiles[kFoveationModeCount] = {XR_NULL_HANDLE, XR_NULL_HANDLE, XR_NULL_HANDLE};
+    bool eyeTrackedSupported = false;
+    bool eyeTrackedFailed = false;      // La creación del perfil falló (p. ej. sin permiso)
+
+    FoveationMode requestedMode = kFoveationFixed;
+    FoveationMode activeMode = kFoveationOff;
+    XrFoveationLevelFB level = XR_FOVEATION_LEVEL_HIGH_FB;
+
+    // Centro de foveation por ojo en NDC, válido solo en modo eye-tracked
+    XrVector2f center[2] = {{0.0f, 0.0f}, {0.0f, 0.0f}};
+    bool centerValid = false;
+
+    FoveationGpuStats gpuStats[kFoveationModeCount];
+
+    bool initialize(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId, XrSession xrSession);
+    void destroy();
+    bool isAvailable() const { return updateSwapchain != nullptr; }
+
+    // Se aplica en el siguiente update(); pedir eye-tracked de nuevo reintenta crear el perfil
+    void setMode(FoveationMode mode);
+
+    // Aplica cambios de modo a los swapchains y consulta el centro de foveation
+    void update(const std::vector<XrSwapchain>& swapchains);
+
+    void recordGpuTime(FoveationMode mode, double gpuMs);
+
+private:
+    XrFoveationProfileFB profileFor(FoveationMode mode);
+    bool apply(FoveationMode mode, const std::vector<XrSwapchain>& swapchains);
+};
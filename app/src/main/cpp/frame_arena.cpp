@@ -0,0 +1,216 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include "native_log.h"
+
+namespace {
+
+// Ordinal del hilo en el FrameArenas que lo asignó; la generación invalida los
+// ordinales de una inicialización anterior
+struct ThreadArenaSlot {
+    const FrameArenas* owner = nullptr;
+    uint32_t generation = 0;
+    uint32_t ordinal = 0;
+};
+thread_local ThreadArenaSlot t_arenaSlot;
+std::atomic<uint32_t> g_arenaGeneration{0};
+uint32_t g_currentGeneration = 0;
+
+#ifdef DEBUG_BUILD
+constexpr uint8_t kPoisonByte = 0xCD;
+#endif
+constexpr uint64_t kFenceTimeoutNs = 100ull * 1000 * 1000;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+bool LinearArena::initialize(size_t bytes) {
+    destroy();
+    base = new (std::nothrow) uint8_t[bytes];
+    if (!base) {
+        LOGE("No se pudo reservar un arena de %zu bytes", bytes);
+        return false;
+    }
+    capacity = bytes;
+    return true;
+}
+
+void LinearArena::destroy() {
+    delete[] base;
+    base = nullptr;
+    capacity = cursor = peak = overflowBytes = 0;
+    overflowFrames = 0;
+    overflowBlocks.clear();
+}
+
+void* LinearArena::allocate(size_t size, size_t alignment) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(base) + cursor;
+    const size_t offset = cursor + (alignUp(address, alignment) - address);
+    if (base && offset + size <= capacity) {
+        cursor = offset + size;
+        return base + offset;
+    }
+
+    // Desbordamiento: bloque propio del heap hasta el siguiente reset
+    std::unique_ptr<uint8_t[]> block(new uint8_t[size + alignment]);
+    const uintptr_t blockAddress = reinterpret_cast<uintptr_t>(block.get());
+    void* result = block.get() + (alignUp(blockAddress, alignment) - blockAddress);
+    overflowBytes += size;
+    overflowBlocks.push_back(std::move(block));
+    return result;
+}
+
+void LinearArena::reset() {
+    const size_t used = cursor + overflowBytes;
+    peak = std::max(peak, used);
+    if (!overflowBlocks.empty()) {
+        overflowFrames++;
+        overflowBlocks.clear();
+    }
+#ifdef DEBUG_BUILD
+    if (base) {
+        memset(base, kPoisonByte, cursor);
+    }
+#endif
+    cursor = 0;
+    overflowBytes = 0;
+}
+
+bool FrameArenas::initialize(uint32_t frameSlots, size_t bytesPerFrame, size_t bytesPerWorker) {
+    destroy();
+    for (uint32_t i = 0; i < frameSlots; i++) {
+        auto slot = std::make_unique<Slot>();
+        if (!slot->main.initialize(bytesPerFrame)) {
+            destroy();
+            return false;
+        }
+        slots.push_back(std::move(slot));
+    }
+    workerBytes = bytesPerWorker;
+    currentSlot = 0;
+    frameOpen = false;
+    g_currentGeneration = ++g_arenaGeneration;
+
+    LOGI("✓ Arenas de frame: %u slots de %zu KB (+%zu KB por worker)",
+         frameSlots, bytesPerFrame / 1024, bytesPerWorker / 1024);
+    return true;
+}
+
+void FrameArenas::destroy() {
+    for (auto& slot : slots) {
+        if (slot->fence) {
+            glDeleteSync(slot->fence);
+        }
+    }
+    slots.clear();
+    threadCount = 0;
+    frameOpen = false;
+}
+
+void FrameArenas::beginFrame() {
+    if (slots.empty()) {
+        return;
+    }
+    // Un frame que no llegó a endFrame (error a mitad) reutiliza su slot
+    if (!frameOpen) {
+        currentSlot = (currentSlot + 1) % static_cast<uint32_t>(slots.size());
+    }
+    Slot& slot = *slots[currentSlot];
+    if (slot.fence) {
+        GLenum result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeoutNs);
+        if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+            LOGE("Timeout esperando el fence del arena de frame %u", currentSlot);
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+
+    slot.main.reset();
+    for (auto& worker : slot.workers) {
+        if (worker) {
+            worker->reset();
+        }
+    }
+    for (auto& worker : slot.extraWorkers) {
+        if (worker) {
+            worker->reset();
+        }
+    }
+    frameOpen = true;
+}
+
+void FrameArenas::endFrame() {
+    if (!frameOpen) {
+        return;
+    }
+    slots[currentSlot]->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frameOpen = false;
+}
+
+LinearArena& FrameArenas::local() {
+    if (t_arenaSlot.owner != this || t_arenaSlot.generation != g_currentGeneration) {
+        std::lock_guard<std::mutex> lock(mutex);
+        t_arenaSlot.owner = this;
+        t_arenaSlot.generation = g_currentGeneration;
+        t_arenaSlot.ordinal = threadCount++;
+    }
+
+    const uint32_t ordinal = t_arenaSlot.ordinal;
+    Slot& slot = *slots[currentSlot];
+    if (ordinal < kMaxArenaThreads) {
+        // La entrada del ordinal solo la toca este hilo: no hace falta el mutex
+        std::unique_ptr<LinearArena>& arena = slot.workers[ordinal];
+        if (!arena) {
+            arena = std::make_unique<LinearArena>();
+            arena->initialize(workerBytes);
+        }
+        return *arena;
+    }
+
+    // Más hilos que sub-arenas fijas: arena de respaldo propio, nunca compartido.
+    // El vector puede crecer desde otros hilos, así que el acceso va bajo el mutex.
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t index = ordinal - kMaxArenaThreads;
+    if (slot.extraWorkers.size() <= index) {
+        slot.extraWorkers.resize(index + 1);
+    }
+    std::unique_ptr<LinearArena>& arena = slot.extraWorkers[index];
+    if (!arena) {
+        LOGE("Hilo %u por encima de %u sub-arenas de frame: arena de respaldo", ordinal, kMaxArenaThreads);
+        arena = std::make_unique<LinearArena>();
+        arena->initialize(workerBytes);
+    }
+    return *arena;
+}
+
+void FrameArenas::logStats() const {
+    size_t mainPeak = 0;
+    size_t workerPeak = 0;
+    uint64_t overflowFrames = 0;
+    for (const auto& slot : slots) {
+        mainPeak = std::max(mainPeak, slot->main.peak);
+        overflowFrames += slot->main.overflowFrames;
+        for (const auto& worker : slot->workers) {
+            if (worker) {
+                workerPeak = std::max(workerPeak, worker->peak);
+                overflowFrames += worker->overflowFrames;
+            }
+        }
+        for (const auto& worker : slot->extraWorkers) {
+            if (worker) {
+                workerPeak = std::max(workerPeak, worker->peak);
+                overflowFrames += worker->overflowFrames;
+            }
+        }
+    }
+    LOGI("Arenas de frame: pico %zu / %zu bytes, pico por worker %zu / %zu bytes, %llu desbordamientos",
+         mainPeak, slots.empty() ? 0 : slots[0]->main.capacity, workerPeak, workerBytes,
+         (unsigned long long)overflowFrames);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Allocator lineal: allocate() solo avanza un cursor y reset() lo devuelve a
+// cero. Si el bloque se agota, lo que no cabe va a bloques de desbordamiento
+// del heap que se liberan en el reset; el pico de uso indica cómo dimensionarlo.
+struct LinearArena {
+    uint8_t* base = nullptr;
+    size_t capacity = 0;
+    size_t cursor = 0;
+    size_t peak = 0;                 // Máximo de bytes usados en un frame (incluido desbordamiento)
+    size_t overflowBytes = 0;        // Bytes del frame actual fuera del bloque
+    uint64_t overflowFrames = 0;     // Frames que no cupieron en el bloque
+
+    bool initialize(size_t bytes);
+    void destroy();
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T>
+    T* allocateArray(size_t count) { return static_cast<T*>(allocate(sizeof(T) * count, alignof(T))); }
+
+    // Con DEBUG_BUILD rellena la memoria liberada con 0xCD para destapar punteros colgados
+    void reset();
+
+private:
+    std::vector<std::unique_ptr<uint8_t[]>> overflowBlocks;
+};
+
+// Adaptador para contenedores STL: deallocate no hace nada, la memoria vuelve
+// al arena en el reset. Conviene reservar para no dejar copias intermedias.
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    LinearArena* arena;
+
+    ArenaAllocator(LinearArena& target) : arena(&target) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return arena->allocateArray<T>(count); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+constexpr uint32_t kMaxArenaThreads = 16;
+
+// Un arena por frame en vuelo más sub-arenas por hilo para los workers. El
+// arena de un frame se reinicia cuando su fence está señalizado, así que los
+// datos pueden seguir referenciados por la GPU hasta entonces.
+struct FrameArenas {
+    bool initialize(uint32_t frameSlots, size_t bytesPerFrame, size_t bytesPerWorker);
+    void destroy();
+    bool isInitialized() const { return !slots.empty(); }
+
+    // Hilo de render: espera el fence del siguiente slot y reinicia sus arenas
+    void beginFrame();
+    // Hilo de render, tras enviar el frame: coloca el fence del slot
+    void endFrame();
+
+    // Arena del hilo de render para el frame actual
+    LinearArena& current() { return slots[currentSlot]->main; }
+    // Sub-arena del hilo que llama (workers del job system); se crea al primer uso.
+    // Los hilos a partir de kMaxArenaThreads reciben un arena propio de respaldo.
+    LinearArena& local();
+
+    void logStats() const;
+
+private:
+    struct Slot {
+        LinearArena main;
+        std::unique_ptr<LinearArena> workers[kMaxArenaThreads];
+        std::vector<std::unique_ptr<LinearArena>> extraWorkers;   // Protegido por mutex
+        GLsync fence = nullptr;
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots;
+    uint32_t currentSlot = 0;
+    bool frameOpen = false;
+    size_t workerBytes = 0;
+    uint32_t threadCount = 0;   // Ordinales de hilo asignados
+    std::mutex mutex;           // Ordinales y arenas de respaldo
+};
@@ -0,0 +1,199 @@
+#include "gl_state_cache.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "native_log.h"
+
+void GlStateCache::beginFrame() {
+    if (stats.issued > 0 || stats.skipped > 0) {
+        stats.frames++;
+        const double weight = 1.0 / static_cast<double>(std::min<uint64_t>(stats.frames, 120));
+        stats.averageIssued += (stats.issued - stats.averageIssued) * weight;
+        stats.averageSkipped += (stats.skipped - stats.averageSkipped) * weight;
+    }
+    stats.issued = 0;
+    stats.skipped = 0;
+    invalidate();
+}
+
+void GlStateCache::invalidate() {
+    program = vao = framebuffer = kUnknown;
+    arrayBuffer = uniformBuffer = pixelUnpackBuffer = kUnknown;
+    for (auto& binding : uniformBindings) {
+        binding = UniformBinding{};
+    }
+    activeUnit = kUnknown;
+    std::fill(std::begin(textures), std::end(textures), kUnknown);
+    blend = depthTest = cullFace = scissorTest = -1;
+    blendSource = blendDestination = depthFunction = kUnknown;
+    depthWrite = -1;
+    std::fill(std::begin(viewportRect), std::end(viewportRect), -1);
+    clearKnown = false;
+}
+
+bool GlStateCache::changed(bool differs) {
+    if (differs) {
+        stats.issued++;
+    } else {
+        stats.skipped++;
+    }
+    return differs;
+}
+
+void GlStateCache::useProgram(GLuint newProgram) {
+    if (changed(program != newProgram)) {
+        glUseProgram(newProgram);
+        program = newProgram;
+    }
+}
+
+void GlStateCache::bindVertexArray(GLuint newVao) {
+    if (changed(vao != newVao)) {
+        glBindVertexArray(newVao);
+        vao = newVao;
+    }
+}
+
+void GlStateCache::bindFramebuffer(GLuint newFramebuffer) {
+    if (changed(framebuffer != newFramebuffer)) {
+        glBindFramebuffer(GL_FRAMEBUFFER, newFramebuffer);
+        framebuffer = newFramebuffer;
+    }
+}
+
+void GlStateCache::bindBuffer(GLenum target, GLuint buffer) {
+    GLuint* slot = nullptr;
+    switch (target) {
+        case GL_ARRAY_BUFFER: slot = &arrayBuffer; break;
+        case GL_UNIFORM_BUFFER: slot = &uniformBuffer; break;
+        case GL_PIXEL_UNPACK_BUFFER: slot = &pixelUnpackBuffer; break;
+        default: break;   // GL_ELEMENT_ARRAY_BUFFER es estado del VAO: no se cachea
+    }
+    if (!slot) {
+        stats.issued++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (changed(*slot != buffer)) {
+        glBindBuffer(target, buffer);
+        *slot = buffer;
+    }
+}
+
+void GlStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    if (target != GL_UNIFORM_BUFFER || index >= kCachedUniformBindings) {
+        stats.issued++;
+        glBindBufferRange(target, index, buffer, offset, size);
+        return;
+    }
+    UniformBinding& binding = uniformBindings[index];
+    if (changed(binding.buffer != buffer || binding.offset != offset || binding.size != size)) {
+        glBindBufferRange(target, index, buffer, offset, size);
+        binding.buffer = buffer;
+        binding.offset = offset;
+        binding.size = size;
+        // glBindBufferRange también cambia el binding genérico del target
+        uniformBuffer = buffer;
+    }
+}
+
+void GlStateCache::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+    if (target != GL_TEXTURE_2D || unit >= kCachedTextureUnits) {
+        stats.issued += 2;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        activeUnit = unit;
+        return;
+    }
+    if (textures[unit] == texture) {
+        stats.skipped++;
+        return;
+    }
+    if (changed(activeUnit != unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        activeUnit = unit;
+    }
+    stats.issued++;
+    glBindTexture(target, texture);
+    textures[unit] = texture;
+}
+
+int8_t* GlStateCache::capabilitySlot(GLenum capability) {
+    switch (capability) {
+        case GL_BLEND: return &blend;
+        case GL_DEPTH_TEST: return &depthTest;
+        case GL_CULL_FACE: return &cullFace;
+        case GL_SCISSOR_TEST: return &scissorTest;
+        default: return nullptr;
+    }
+}
+
+void GlStateCache::setEnabled(GLenum capability, bool enabled) {
+    int8_t* slot = capabilitySlot(capability);
+    const int8_t value = enabled ? 1 : 0;
+    if (slot && !changed(*slot != value)) {
+        return;
+    }
+    if (!slot) {
+        stats.issued++;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    if (slot) {
+        *slot = value;
+    }
+}
+
+void GlStateCache::blendFunc(GLenum source, GLenum destination) {
+    if (changed(blendSource != source || blendDestination != destination)) {
+        glBlendFunc(source, destination);
+        blendSource = source;
+        blendDestination = destination;
+    }
+}
+
+void GlStateCache::depthFunc(GLenum function) {
+    if (changed(depthFunction != function)) {
+        glDepthFunc(function);
+        depthFunction = function;
+    }
+}
+
+void GlStateCache::depthMask(bool enabled) {
+    const int8_t value = enabled ? 1 : 0;
+    if (changed(depthWrite != value)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        depthWrite = value;
+    }
+}
+
+void GlStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (changed(viewportRect[0] != x || viewportRect[1] != y || viewportRect[2] != width || viewportRect[3] != height)) {
+        glViewport(x, y, width, height);
+        viewportRect[0] = x;
+        viewportRect[1] = y;
+        viewportRect[2] = width;
+        viewportRect[3] = height;
+    }
+}
+
+void GlStateCache::clearColor(float red, float green, float blue, float alpha) {
+    if (changed(!clearKnown || clear[0] != red || clear[1] != green || clear[2] != blue || clear[3] != alpha)) {
+        glClearColor(red, green, blue, alpha);
+        clear[0] = red;
+        clear[1] = green;
+        clear[2] = blue;
+        clear[3] = alpha;
+        clearKnown = true;
+    }
+}
+
+void GlStateCache::logStats() const {
+    const double total = stats.averageIssued + stats.averageSkipped;
+    LOGI("Estado GL por frame: %.1f llamadas emitidas, %.1f filtradas (%.0f%%)",
+         stats.averageIssued, stats.averageSkipped, total > 0.0 ? 100.0 * stats.averageSkipped / total : 0.0);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <cstdint>
+
+constexpr uint32_t kCachedTextureUnits = 8;
+constexpr uint32_t kCachedUniformBindings = 4;
+
+// Llamadas GL emitidas y filtradas por la caché
+struct GlStateStats {
+    uint32_t issued = 0;         // Del frame actual
+    uint32_t skipped = 0;
+    double averageIssued = 0.0;  // Media móvil por frame
+    double averageSkipped = 0.0;
+    uint64_t frames = 0;
+};
+
+// Sombra del estado GL del contexto dedicado: cada setter compara con el último
+// valor conocido y solo llama a GL si cambia. El estado empieza desconocido y
+// vuelve a estarlo con invalidate(), que debe llamarse cuando otro código haya
+// podido tocar GL sin pasar por aquí (inicio del render de cada frame).
+struct GlStateCache {
+    GlStateStats stats;
+
+    GlStateCache() { invalidate(); }
+
+    // Cierra las cuentas del frame anterior e invalida el estado
+    void beginFrame();
+    void invalidate();
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+    void bindFramebuffer(GLuint framebuffer);   // GL_FRAMEBUFFER (lectura y escritura)
+    void bindBuffer(GLenum target, GLuint buffer);
+    void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    void bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+    void setEnabled(GLenum capability, bool enabled);
+    void blendFunc(GLenum source, GLenum destination);
+    void depthFunc(GLenum function);
+    void depthMask(bool enabled);
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void clearColor(float red, float green, float blue, float alpha);
+
+    void logStats() const;
+
+private:
+    static constexpr GLuint kUnknown = 0xFFFFFFFFu;
+
+    // Devuelve true si hay que emitir la llamada y actualiza las cuentas
+    bool changed(bool differs);
+    int8_t* capabilitySlot(GLenum capability);
+
+    GLuint program = kUnknown;
+    GLuint vao = kUnknown;
+    GLuint framebuffer = kUnknown;
+    GLuint arrayBuffer = kUnknown;
+    GLuint uniformBuffer = kUnknown;
+    GLuint pixelUnpackBuffer = kUnknown;
+    struct UniformBinding {
+        GLuint buffer = kUnknown;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+    } uniformBindings[kCachedUniformBindings];
+    GLuint activeUnit = kUnknown;
+    GLuint textures[kCachedTextureUnits];
+
+    // -1 desconocido, 0 desactivado, 1 activado
+    int8_t blend = -1;
+    int8_t depthTest = -1;
+    int8_t cullFace = -1;
+    int8_t scissorTest = -1;
+    GLenum blendSource = kUnknown;
+    GLenum blendDestination = kUnknown;
+    GLenum depthFunction = kUnknown;
+    int8_t depthWrite = -1;
+    GLint viewportRect[4] = {-1, -1, -1, -1};
+    float clear[4] = {};
+    bool clearKnown = false;
+};
@@ -0,0 +1,90 @@
+#include "gpu_timer.h"
+
+#include <EGL/egl.h>
+#include <cstring>
+
+#include "native_log.h"
+
+bool GpuTimer::initialize(uint32_t queryCount) {
+    destroy();
+
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (!extensions || !strstr(extensions, "GL_EXT_disjoint_timer_query")) {
+        LOGI("GL_EXT_disjoint_timer_query no disponible, sin tiempos de GPU");
+        return false;
+    }
+    getQueryObjectui64v = reinterpret_cast<PFNGLGETQUERYOBJECTUI64VEXTPROC>(
+            eglGetProcAddress("glGetQueryObjectui64vEXT"));
+    if (!getQueryObjectui64v) {
+        LOGE("glGetQueryObjectui64vEXT no disponible");
+        return false;
+    }
+
+    std::vector<GLuint> ids(queryCount);
+    glGenQueries(queryCount, ids.data());
+    queries.resize(queryCount);
+    for (uint32_t i = 0; i < queryCount; i++) {
+        queries[i].id = ids[i];
+    }
+
+    // Descartar un posible disjoint previo a la creación
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    LOGI("✓ Temporizador GPU con %u consultas", queryCount);
+    return true;
+}
+
+void GpuTimer::destroy() {
+    if (activeQuery >= 0) {
+        glEndQuery(GL_TIME_ELAPSED_EXT);
+        activeQuery = -1;
+    }
+    for (auto& query : queries) {
+        glDeleteQueries(1, &query.id);
+    }
+    queries.clear();
+    nextQuery = 0;
+    getQueryObjectui64v = nullptr;
+}
+
+bool GpuTimer::begin(uint32_t tag) {
+    if (queries.empty()) {
+        return false;
+    }
+    if (activeQuery >= 0) {
+        // Un frame anterior salió por una ruta de error sin cerrar su intervalo
+        end();
+    }
+    Query& query = queries[nextQuery];
+    if (query.pending) {
+        return false;
+    }
+    glBeginQuery(GL_TIME_ELAPSED_EXT, query.id);
+    query.tag = tag;
+    activeQuery = static_cast<int32_t>(nextQuery);
+    nextQuery = (nextQuery + 1) % static_cast<uint32_t>(queries.size());
+    return true;
+}
+
+void GpuTimer::end() {
+    if (activeQuery < 0) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+    queries[activeQuery].pending = true;
+    activeQuery = -1;
+}
+
+bool GpuTimer::readResult(Query& query, uint64_t& elapsedNs) {
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return false;
+    }
+    GLuint64 result = 0;
+    getQueryObjectui64v(query.id, GL_QUERY_RESULT, &result);
+    query.pending = false;
+    elapsedNs = result;
+    return true;
+}
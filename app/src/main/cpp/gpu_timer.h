@@ -0,0 +1,54 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <GLES2/gl2ext.h>
+#include <cstdint>
+#include <vector>
+
+// Medición de tiempo de GPU con GL_EXT_disjoint_timer_query. Las consultas se
+// leen varios frames después (sin bloquear) y cada una lleva una etiqueta del
+// llamador para agrupar resultados.
+struct GpuTimer {
+    struct Query {
+        GLuint id = 0;
+        uint32_t tag = 0;
+        bool pending = false;
+    };
+
+    std::vector<Query> queries;
+    uint32_t nextQuery = 0;
+    int32_t activeQuery = -1;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC getQueryObjectui64v = nullptr;
+
+    bool initialize(uint32_t queryCount);
+    void destroy();
+    bool isAvailable() const { return !queries.empty(); }
+
+    // Sin consultas libres (GPU muy retrasada) el intervalo no se mide
+    bool begin(uint32_t tag);
+    void end();
+
+    // Entrega los resultados disponibles: onResult(tag, nanosegundos)
+    template <typename Callback>
+    void collect(Callback&& onResult);
+
+private:
+    bool readResult(Query& query, uint64_t& elapsedNs);
+};
+
+template <typename Callback>
+void GpuTimer::collect(Callback&& onResult) {
+    if (queries.empty()) {
+        return;
+    }
+    // Un evento disjoint (cambio de frecuencia, preempción) invalida las consultas en vuelo
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    for (auto& query : queries) {
+        uint64_t elapsedNs = 0;
+        if (query.pending && readResult(query, elapsedNs) && !disjoint) {
+            onResult(query.tag, elapsedNs);
+        }
+    }
+}
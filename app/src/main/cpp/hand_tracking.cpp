@@ -0,0 +1,128 @@
+#include "hand_tracking.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "native_log.h"
+#include "xr_check.h"
+#include "xr_dispatch.h"
+
+namespace {
+
+// Cada cuántos frames se escribe el coste medio en el log
+constexpr uint64_t kStatsLogInterval = 900;
+
+} // namespace
+
+bool HandTracking::initialize(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId, XrSession session) {
+    createHandTracker = dispatch.xrCreateHandTrackerEXT;
+    destroyHandTracker = dispatch.xrDestroyHandTrackerEXT;
+    locateHandJoints = dispatch.xrLocateHandJointsEXT;
+    if (!createHandTracker || !destroyHandTracker || !locateHandJoints) {
+        return false;
+    }
+
+    XrSystemHandTrackingPropertiesEXT handTrackingProperties{XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT};
+    XrSystemProperties systemProperties{XR_TYPE_SYSTEM_PROPERTIES};
+    systemProperties.next = &handTrackingProperties;
+    if (!CheckXrResult(xrGetSystemProperties(instance, systemId, &systemProperties), "xrGetSystemProperties (manos)")) {
+        return false;
+    }
+    if (!handTrackingProperties.supportsHandTracking) {
+        LOGI("El sistema no soporta hand tracking");
+        return false;
+    }
+
+    const XrHandEXT handIds[kHandCount] = {XR_HAND_LEFT_EXT, XR_HAND_RIGHT_EXT};
+    for (uint32_t hand = 0; hand < kHandCount; hand++) {
+        XrHandTrackerCreateInfoEXT createInfo{XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT};
+        createInfo.hand = handIds[hand];
+        createInfo.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+        if (!CheckXrResult(createHandTracker(session, &createInfo, &trackers[hand]), "xrCreateHandTrackerEXT")) {
+            destroy();
+            return false;
+        }
+        hands[hand] = HandJointsSoA{};
+    }
+
+    stats = HandTrackingStats{};
+    LOGI("✓ Hand tracking listo (%u articulaciones por mano)", kHandJointCount);
+    return true;
+}
+
+void HandTracking::destroy() {
+    for (auto& tracker : trackers) {
+        if (tracker != XR_NULL_HANDLE && destroyHandTracker) {
+            destroyHandTracker(tracker);
+        }
+        tracker = XR_NULL_HANDLE;
+    }
+    for (auto& hand : hands) {
+        hand = HandJointsSoA{};
+    }
+}
+
+void HandTracking::update(XrSpace baseSpace, XrTime time) {
+    if (!isAvailable()) {
+        return;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+
+    constexpr XrSpaceLocationFlags kTrackedBits =
+            XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+
+    for (uint32_t hand = 0; hand < kHandCount; hand++) {
+        HandJointsSoA& joints = hands[hand];
+        XrHandJointLocationEXT* locations = scratchLocations[hand];
+
+        XrHandJointLocationsEXT jointLocations{XR_TYPE_HAND_JOINT_LOCATIONS_EXT};
+        jointLocations.jointCount = kHandJointCount;
+        jointLocations.jointLocations = locations;
+
+        XrHandJointsLocateInfoEXT locateInfo{XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT};
+        locateInfo.baseSpace = baseSpace;
+        locateInfo.time = time;
+
+        XrResult result = locateHandJoints(trackers[hand], &locateInfo, &jointLocations);
+        if (XR_FAILED(result) || !jointLocations.isActive) {
+            joints.active = false;
+            joints.positionValid = joints.orientationValid = joints.tracked = 0;
+            continue;
+        }
+
+        // AoS -> SoA
+        uint32_t positionValid = 0;
+        uint32_t orientationValid = 0;
+        uint32_t tracked = 0;
+        for (uint32_t joint = 0; joint < kHandJointCount; joint++) {
+            const XrHandJointLocationEXT& location = locations[joint];
+            joints.positionX[joint] = location.pose.position.x;
+            joints.positionY[joint] = location.pose.position.y;
+            joints.positionZ[joint] = location.pose.position.z;
+            joints.orientationX[joint] = location.pose.orientation.x;
+            joints.orientationY[joint] = location.pose.orientation.y;
+            joints.orientationZ[joint] = location.pose.orientation.z;
+            joints.orientationW[joint] = location.pose.orientation.w;
+            joints.radius[joint] = location.radius;
+
+            const uint32_t bit = 1u << joint;
+            if (location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) positionValid |= bit;
+            if (location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) orientationValid |= bit;
+            if ((location.locationFlags & kTrackedBits) == kTrackedBits) tracked |= bit;
+        }
+        joints.positionValid = positionValid;
+        joints.orientationValid = orientationValid;
+        joints.tracked = tracked;
+        joints.active = true;
+    }
+
+    double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+    stats.frames++;
+    stats.lastUpdateUs = elapsedUs;
+    stats.peakUpdateUs = std::max(stats.peakUpdateUs, elapsedUs);
+    stats.averageUpdateUs += (elapsedUs - stats.averageUpdateUs) / static_cast<double>(std::min<uint64_t>(stats.frames, 120));
+    if (stats.frames % kStatsLogInterval == 0) {
+        LOGI("Hand tracking: %.1f us/frame de media, pico %.1f us", stats.averageUpdateUs, stats.peakUpdateUs);
+        stats.peakUpdateUs = 0.0;
+    }
+}
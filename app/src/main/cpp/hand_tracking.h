@@ -0,0 +1,59 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cstdint>
+
+#include "xr_input.h"
+
+struct XrDispatch;
+
+constexpr uint32_t kHandJointCount = XR_HAND_JOINT_COUNT_EXT;
+
+// Articulaciones de una mano en layout SoA: cada componente en su propio array
+// alineado a 16 bytes para que los consumidores lo procesen con NEON de 4 en 4.
+// El índice de cada array es XrHandJointEXT.
+struct HandJointsSoA {
+    alignas(16) float positionX[kHandJointCount];
+    alignas(16) float positionY[kHandJointCount];
+    alignas(16) float positionZ[kHandJointCount];
+    alignas(16) float orientationX[kHandJointCount];
+    alignas(16) float orientationY[kHandJointCount];
+    alignas(16) float orientationZ[kHandJointCount];
+    alignas(16) float orientationW[kHandJointCount];
+    alignas(16) float radius[kHandJointCount];
+    uint32_t positionValid = 0;      // Bit (1 << joint)
+    uint32_t orientationValid = 0;
+    uint32_t tracked = 0;            // Posición y orientación con tracking real (no inferidas)
+    bool active = false;
+};
+
+// Estadísticas del coste por frame de localizar las articulaciones
+struct HandTrackingStats {
+    double lastUpdateUs = 0.0;
+    double averageUpdateUs = 0.0;
+    double peakUpdateUs = 0.0;
+    uint64_t frames = 0;
+};
+
+// XR_EXT_hand_tracking: un tracker por mano creado con la sesión y una llamada
+// a xrLocateHandJointsEXT por mano y frame (las 26 articulaciones a la vez).
+struct HandTracking {
+    PFN_xrCreateHandTrackerEXT createHandTracker = nullptr;
+    PFN_xrDestroyHandTrackerEXT destroyHandTracker = nullptr;
+    PFN_xrLocateHandJointsEXT locateHandJoints = nullptr;
+
+    XrHandTrackerEXT trackers[kHandCount] = {XR_NULL_HANDLE, XR_NULL_HANDLE};
+    HandJointsSoA hands[kHandCount];
+    HandTrackingStats stats;
+
+    bool initialize(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId, XrSession session);
+    void destroy();
+    bool isAvailable() const { return trackers[kHandLeft] != XR_NULL_HANDLE; }
+
+    // Localiza ambas manos respecto a baseSpace; sin asignaciones de memoria
+    void update(XrSpace baseSpace, XrTime time);
+
+private:
+    // Scratch preasignado en formato AoS tal como lo devuelve el runtime
+    XrHandJointLocationEXT scratchLocations[kHandCount][kHandJointCount];
+};
@@ -0,0 +1,288 @@
+#include "job_system.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "native_log.h"
+#include "thread_registry.h"
+
+namespace {
+
+// Cola del hilo actual en el pool al que pertenece (los externos usan la 0)
+thread_local const JobSystem* t_jobSystem = nullptr;
+thread_local uint32_t t_queueIndex = 0;
+
+// Trozos por hilo en parallelFor: margen para equilibrar sin multiplicar colas
+constexpr uint32_t kChunksPerThread = 4;
+
+} // namespace
+
+bool JobSystem::start(uint32_t workerCount, ThreadRegistry* threadRegistry) {
+    if (!queues.empty()) {
+        return true;
+    }
+    if (workerCount == kAutoWorkerCount) {
+        // El hilo que espera también ejecuta trabajo y ocupa uno de los núcleos grandes
+        const uint32_t bigCores = queryCpuTopology().bigCount();
+        workerCount = bigCores > 1 ? bigCores - 1 : 0;
+    }
+
+    registry = threadRegistry;
+    stopRequested = false;
+    queuedJobs = 0;
+    for (uint32_t i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (uint32_t i = 1; i <= workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerMain, this, i);
+    }
+    LOGI("✓ Job system con %u workers (%s)", workerCount, workerCount ? "work stealing" : "en línea");
+    return true;
+}
+
+void JobSystem::stop() {
+    if (queues.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopRequested = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // Lo que quedara encolado se ejecuta aquí para no dejar contadores colgados
+    while (executeOne(0)) {
+    }
+    queues.clear();
+    registry = nullptr;
+}
+
+void JobSystem::run(JobCounter& counter, JobFunction job) {
+    if (workers.empty()) {
+        job();
+        stats.executed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    const uint32_t queueIndex = currentQueue();
+    {
+        std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+        queues[queueIndex]->jobs.push_back({std::move(job), &counter, queueIndex});
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    // Pasar por el mutex evita perder el aviso si un worker está a punto de dormir
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    const uint32_t queueIndex = currentQueue();
+    while (!counter.done()) {
+        if (!executeOne(queueIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(uint32_t count, uint32_t grain, const RangeFunction& body) {
+    if (count == 0) {
+        return;
+    }
+    const uint32_t maxChunks = concurrency() * kChunksPerThread;
+    const uint32_t chunkSize = std::max(std::max(grain, 1u), (count + maxChunks - 1) / maxChunks);
+    if (workers.empty() || chunkSize >= count) {
+        body(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t begin = chunkSize; begin < count; begin += chunkSize) {
+        const uint32_t end = std::min(count, begin + chunkSize);
+        run(counter, [&body, begin, end]() { body(begin, end); });
+    }
+    // El primer trozo lo hace el hilo que llama mientras los workers roban el resto
+    body(0, chunkSize);
+    wait(counter);
+}
+
+void JobSystem::logStats() const {
+    LOGI("Job system: %llu trabajos, %llu robados, %u hilos",
+         (unsigned long long)stats.executed.load(std::memory_order_relaxed),
+         (unsigned long long)stats.stolen.load(std::memory_order_relaxed), concurrency());
+}
+
+uint32_t JobSystem::currentQueue() const {
+    return t_jobSystem == this ? t_queueIndex : 0;
+}
+
+bool JobSystem::pop(uint32_t queueIndex, Job& job) {
+    WorkQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(uint32_t thiefIndex, Job& job) {
+    const uint32_t queueCount = static_cast<uint32_t>(queues.size());
+    for (uint32_t offset = 1; offset < queueCount; offset++) {
+        WorkQueue& queue = *queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::executeOne(uint32_t queueIndex) {
+    Job job;
+    if (!pop(queueIndex, job) && !steal(queueIndex, job)) {
+        return false;
+    }
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+    job.function();
+    stats.executed.fetch_add(1, std::memory_order_relaxed);
+    if (job.sourceQueue != queueIndex) {
+        stats.stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (job.counter) {
+        job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return true;
+}
+
+void JobSystem::workerMain(uint32_t queueIndex) {
+    t_jobSystem = this;
+    t_queueIndex = queueIndex;
+    if (registry) {
+        char name[16];
+        snprintf(name, sizeof(name), "xr_job%u", queueIndex);
+        registry->registerCurrentThread(kThreadRoleWorker, name);
+    }
+
+    while (!stopRequested.load(std::memory_order_acquire)) {
+        if (executeOne(queueIndex)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] {
+            return stopRequested.load(std::memory_order_acquire) || queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+
+    if (registry) {
+        registry->unregisterCurrentThread();
+    }
+    t_jobSystem = nullptr;
+}
+
+TaskId FrameTaskGraph::add(const char* name, JobFunction function, std::initializer_list<TaskId> dependencies) {
+    const TaskId id = static_cast<TaskId>(nodes.size());
+    auto node = std::make_unique<Node>();
+    node->name = name;
+    node->function = std::move(function);
+    for (TaskId dependency : dependencies) {
+        if (dependency >= id) {
+            LOGE("Tarea %s: dependencia %u inexistente", name, dependency);
+            continue;
+        }
+        nodes[dependency]->successors.push_back(id);
+        node->dependencyCount++;
+    }
+    nodes.push_back(std::move(node));
+    return id;
+}
+
+void FrameTaskGraph::execute(JobSystem& jobs) {
+    if (nodes.empty()) {
+        return;
+    }
+    activeJobs = &jobs;
+    for (auto& node : nodes) {
+        node->remaining.store(node->dependencyCount, std::memory_order_relaxed);
+    }
+    for (TaskId id = 0; id < nodes.size(); id++) {
+        if (nodes[id]->dependencyCount == 0) {
+            schedule(id);
+        }
+    }
+    jobs.wait(counter);
+    activeJobs = nullptr;
+}
+
+void FrameTaskGraph::clear() {
+    nodes.clear();
+}
+
+void FrameTaskGraph::schedule(TaskId id) {
+    activeJobs->run(counter, [this, id]() {
+        Node& node = *nodes[id];
+        node.function();
+        // El último predecesor en terminar lanza la tarea
+        for (TaskId successor : node.successors) {
+            if (nodes[successor]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                schedule(successor);
+            }
+        }
+    });
+}
+
+void runJobSystemBenchmark() {
+    constexpr uint32_t kElements = 1u << 18;
+    constexpr uint32_t kGrain = 1024;
+    constexpr uint32_t kRuns = 5;
+
+    const CpuTopology topology = queryCpuTopology();
+    const uint32_t maxThreads = std::max(topology.coreCount(), 1u);
+    LOGI("=== Benchmark del job system: 1..%u hilos (%u núcleos grandes) ===", maxThreads, topology.bigCount());
+
+    // Trabajo de CPU puro por elemento, independiente entre elementos
+    std::vector<float> data(kElements);
+    auto body = [&data](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            float value = static_cast<float>(i);
+            for (uint32_t k = 0; k < 256; k++) {
+                value = value * 0.999f + 0.001f * static_cast<float>(k);
+            }
+            data[i] = value;
+        }
+    };
+
+    double singleThreadMs = 0.0;
+    for (uint32_t threads = 1; threads <= maxThreads; threads++) {
+        JobSystem jobs;
+        jobs.start(threads - 1);
+        jobs.parallelFor(kElements, kGrain, body);   // Calentamiento
+
+        double bestMs = 0.0;
+        for (uint32_t run = 0; run < kRuns; run++) {
+            const auto start = std::chrono::steady_clock::now();
+            jobs.parallelFor(kElements, kGrain, body);
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            bestMs = run == 0 ? ms : std::min(bestMs, ms);
+        }
+        if (threads == 1) {
+            singleThreadMs = bestMs;
+        }
+        const double speedup = bestMs > 0.0 ? singleThreadMs / bestMs : 0.0;
+        LOGI("  %u hilos: %.2f ms, aceleración x%.2f, eficiencia %.0f%%, %llu robados",
+             threads, bestMs, speedup, 100.0 * speedup / threads,
+             (unsigned long long)jobs.stats.stolen.load(std::memory_order_relaxed));
+        jobs.stop();
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ThreadRegistry;
+
+// start(): un worker por núcleo grande menos el del hilo que espera
+constexpr uint32_t kAutoWorkerCount = UINT32_MAX;
+
+using JobFunction = std::function<void()>;
+// Cuerpo de parallelFor: procesa el rango [begin, end)
+using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+// Contador de dependencias: run() lo incrementa y cada trabajo terminado lo
+// decrementa. Quien espera un grupo de trabajos espera su contador.
+struct JobCounter {
+    std::atomic<uint32_t> pending{0};
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+struct JobSystemStats {
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> stolen{0};   // Ejecutados por un hilo distinto del que los encoló
+};
+
+// Pool fijo de hilos con work stealing. Cada worker tiene su cola: encola y
+// saca por detrás (LIFO, caché caliente) y los demás le roban por delante.
+// Los hilos externos (render) usan una cola compartida y ayudan en wait(), así
+// que el pool se dimensiona a los núcleos grandes menos el del render.
+struct JobSystem {
+    JobSystemStats stats;
+
+    // Sin workers (un solo núcleo grande o workerCount 0), run() ejecuta en línea
+    bool start(uint32_t workerCount = kAutoWorkerCount, ThreadRegistry* threadRegistry = nullptr);
+    void stop();
+    bool isRunning() const { return !workers.empty(); }
+    // Hilos que ejecutan trabajo: los workers más el que espera
+    uint32_t concurrency() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+    void run(JobCounter& counter, JobFunction job);
+    // Ejecuta trabajos pendientes hasta que el contador llegue a cero
+    void wait(JobCounter& counter);
+
+    // Fork-join: reparte [0, count) en trozos de al menos grain elementos y espera
+    void parallelFor(uint32_t count, uint32_t grain, const RangeFunction& body);
+
+    void logStats() const;
+
+private:
+    struct Job {
+        JobFunction function;
+        JobCounter* counter = nullptr;
+        uint32_t sourceQueue = 0;
+    };
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    uint32_t currentQueue() const;
+    bool pop(uint32_t queueIndex, Job& job);
+    bool steal(uint32_t thiefIndex, Job& job);
+    bool executeOne(uint32_t queueIndex);
+    void workerMain(uint32_t queueIndex);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;   // [0] hilos externos, [1..N] workers
+    std::vector<std::thread> workers;
+    ThreadRegistry* registry = nullptr;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<uint32_t> queuedJobs{0};
+    std::atomic<bool> stopRequested{false};
+};
+
+using TaskId = uint32_t;
+
+// Grafo de tareas de un frame: se construye una vez y se ejecuta cada frame.
+// Cada nodo arranca cuando terminan sus dependencias; execute() bloquea al
+// hilo que llama, que ejecuta tareas mientras espera.
+struct FrameTaskGraph {
+    // Las dependencias deben haberse añadido antes
+    TaskId add(const char* name, JobFunction function, std::initializer_list<TaskId> dependencies = {});
+    void execute(JobSystem& jobs);
+    void clear();
+    bool empty() const { return nodes.empty(); }
+
+private:
+    struct Node {
+        const char* name = nullptr;
+        JobFunction function;
+        std::vector<TaskId> successors;
+        uint32_t dependencyCount = 0;
+        std::atomic<uint32_t> remaining{0};
+    };
+
+    void schedule(TaskId id);
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    JobSystem* activeJobs = nullptr;   // Solo durante execute()
+    JobCounter counter;
+};
+
+// Escalado del pool en el host: el mismo trabajo con 1..N hilos (solo logs)
+void runJobSystemBenchmark();
@@ -0,0 +1,120 @@
+#include "late_latch.h"
+
+#include <EGL/egl.h>
+#include <GLES2/gl2ext.h>
+#include <cstring>
+
+#include "gl_state_cache.h"
+#include "native_log.h"
+
+namespace {
+
+constexpr GLuint64 kFenceWaitTimeoutNs = 100000000; // 100 ms
+
+} // namespace
+
+bool LateLatchBuffer::initialize(uint32_t frameSlots) {
+    destroy();
+
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    PFNGLBUFFERSTORAGEEXTPROC pfnBufferStorage = nullptr;
+    if (extensions && strstr(extensions, "GL_EXT_buffer_storage")) {
+        pfnBufferStorage = reinterpret_cast<PFNGLBUFFERSTORAGEEXTPROC>(eglGetProcAddress("glBufferStorageEXT"));
+    }
+    if (!pfnBufferStorage) {
+        LOGI("Late latching no disponible: falta GL_EXT_buffer_storage");
+        return false;
+    }
+
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment <= 0) {
+        alignment = 256;
+    }
+    viewStride = (static_cast<GLsizeiptr>(sizeof(ViewUniforms)) + alignment - 1) / alignment * alignment;
+    slotCount = frameSlots;
+    const GLsizeiptr totalSize = viewStride * kViewCount * slotCount;
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    pfnBufferStorage(GL_UNIFORM_BUFFER, totalSize, nullptr, flags);
+    mapped = static_cast<uint8_t*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, totalSize, flags));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    if (!mapped) {
+        LOGE("Mapeo coherente para late latching falló: 0x%x", glGetError());
+        destroy();
+        return false;
+    }
+
+    fences.assign(slotCount, nullptr);
+    currentSlot = slotCount - 1;
+    LOGI("✓ Buffer de late latching: %u slots x %u vistas (%ld bytes por vista)",
+         slotCount, kViewCount, static_cast<long>(viewStride));
+    return true;
+}
+
+void LateLatchBuffer::destroy() {
+    for (auto& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+    fences.clear();
+
+    if (buffer != 0) {
+        if (mapped) {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    mapped = nullptr;
+    slotCount = 0;
+    viewStride = 0;
+}
+
+bool LateLatchBuffer::beginFrame() {
+    if (!mapped) {
+        return false;
+    }
+    currentSlot = (currentSlot + 1) % slotCount;
+
+    GLsync& fence = fences[currentSlot];
+    if (fence) {
+        GLenum waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceWaitTimeoutNs);
+        while (waitResult == GL_TIMEOUT_EXPIRED) {
+            waitResult = glClientWaitSync(fence, 0, kFenceWaitTimeoutNs);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+        if (waitResult == GL_WAIT_FAILED) {
+            LOGE("glClientWaitSync falló en late latching: 0x%x", glGetError());
+            return false;
+        }
+    }
+    return true;
+}
+
+void LateLatchBuffer::write(uint32_t view, const ViewUniforms& data) {
+    memcpy(mapped + (currentSlot * kViewCount + view) * viewStride, &data, sizeof(ViewUniforms));
+}
+
+void LateLatchBuffer::bind(GlStateCache& state, GLuint bindingPoint, uint32_t view) const {
+    state.bindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, buffer,
+                          (currentSlot * kViewCount + view) * viewStride, sizeof(ViewUniforms));
+}
+
+void LateLatchBuffer::endFrame() {
+    if (!mapped) {
+        return;
+    }
+    GLsync& fence = fences[currentSlot];
+    if (fence) {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
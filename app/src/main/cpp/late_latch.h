@@ -0,0 +1,38 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <cstdint>
+#include <vector>
+
+#include "uniform_ring.h"
+
+// Buffer pequeño de poses de vista para late latching. Los draws se graban
+// leyendo este UBO y, justo antes de enviar el trabajo a la GPU, se vuelven a
+// localizar las vistas y se reescribe su contenido.
+//
+// Necesita un mapeo persistente y coherente (GL_EXT_buffer_storage): la escritura
+// tardía tiene que llegar a la GPU sin comandos GL adicionales, ya que los draws
+// que la leen ya están en la cola. Sin la extensión initialize() devuelve false.
+struct LateLatchBuffer {
+    static constexpr uint32_t kViewCount = 2;
+
+    GLuint buffer = 0;
+    uint8_t* mapped = nullptr;
+    uint32_t slotCount = 0;
+    GLsizeiptr viewStride = 0;       // ViewUniforms alineado a GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    uint32_t currentSlot = 0;
+    std::vector<GLsync> fences;
+
+    bool initialize(uint32_t frameSlots);
+    void destroy();
+    bool isAvailable() const { return mapped != nullptr; }
+
+    // Espera a que la GPU termine con el siguiente slot
+    bool beginFrame();
+
+    // Escribe (o parchea) los datos de una vista del slot actual
+    void write(uint32_t view, const ViewUniforms& data);
+    void bind(GlStateCache& state, GLuint bindingPoint, uint32_t view) const;
+
+    void endFrame();
+};
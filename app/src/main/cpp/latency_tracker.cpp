@@ -0,0 +1,103 @@
+#include "latency_tracker.h"
+
+#include <algorithm>
+
+#include "native_log.h"
+#include "xr_dispatch.h"
+
+void LatencyHistogram::add(int64_t latencyNs) {
+    // Latencias negativas (marca posterior al display) cuentan en la primera cubeta
+    const int64_t bucket = std::max<int64_t>(latencyNs, 0) / kBucketWidthNs;
+    buckets[std::min<int64_t>(bucket, kBucketCount - 1)]++;
+    count++;
+    sumNs += latencyNs;
+    maxNs = std::max(maxNs, latencyNs);
+}
+
+bool LatencyTracker::initialize(const XrDispatch& dispatch, XrInstance xrInstance) {
+    convertTimespecTime = dispatch.xrConvertTimespecTimeToTimeKHR;
+    if (!convertTimespecTime) {
+        LOGI("Medición de latencia no disponible (falta XR_KHR_convert_timespec_time)");
+        return false;
+    }
+    instance = xrInstance;
+    reset();
+    LOGI("✓ Medición de latencia input-to-photon activa");
+    return true;
+}
+
+void LatencyTracker::destroy() {
+    convertTimespecTime = nullptr;
+    instance = XR_NULL_HANDLE;
+    frameOpen = false;
+}
+
+int64_t LatencyTracker::monotonicNowNs() const {
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000ll + now.tv_nsec;
+}
+
+void LatencyTracker::beginFrame() {
+    if (!isAvailable()) {
+        return;
+    }
+
+    // Una sola conversión por frame: el resto de marcas reutilizan el desplazamiento
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    XrTime xrNow = 0;
+    if (XR_FAILED(convertTimespecTime(instance, &now, &xrNow))) {
+        frameOpen = false;
+        return;
+    }
+    clockOffsetNs = xrNow - (static_cast<int64_t>(now.tv_sec) * 1000000000ll + now.tv_nsec);
+
+    std::fill(std::begin(marked), std::end(marked), false);
+    frameOpen = true;
+}
+
+void LatencyTracker::mark(LatencyStage stage) {
+    if (!frameOpen) {
+        return;
+    }
+    // Una marca repetida (p. ej. el xrLocateViews tardío) sustituye a la anterior
+    marksNs[stage] = monotonicNowNs() + clockOffsetNs;
+    marked[stage] = true;
+}
+
+void LatencyTracker::endFrame(XrTime predictedDisplayTime) {
+    if (!frameOpen) {
+        return;
+    }
+    frameOpen = false;
+
+    std::lock_guard<std::mutex> lock(histogramMutex);
+    for (uint32_t stage = 0; stage < kLatencyStageCount; stage++) {
+        if (marked[stage]) {
+            histograms[stage].add(predictedDisplayTime - marksNs[stage]);
+        }
+    }
+}
+
+void LatencyTracker::exportHistograms(std::vector<int64_t>& out) {
+    std::lock_guard<std::mutex> lock(histogramMutex);
+    out.clear();
+    out.reserve(3 + kLatencyStageCount * (3 + LatencyHistogram::kBucketCount));
+    out.push_back(kLatencyStageCount);
+    out.push_back(LatencyHistogram::kBucketCount);
+    out.push_back(LatencyHistogram::kBucketWidthNs);
+    for (const auto& histogram : histograms) {
+        out.push_back(static_cast<int64_t>(histogram.count));
+        out.push_back(histogram.sumNs);
+        out.push_back(histogram.maxNs);
+        out.insert(out.end(), std::begin(histogram.buckets), std::end(histogram.buckets));
+    }
+}
+
+void LatencyTracker::reset() {
+    std::lock_guard<std::mutex> lock(histogramMutex);
+    for (auto& histogram : histograms) {
+        histogram = LatencyHistogram{};
+    }
+}
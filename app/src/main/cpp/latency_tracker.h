@@ -0,0 +1,67 @@
+#pragma once
+
+#include <jni.h>
+#include <EGL/egl.h>
+#include <time.h>
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+struct XrDispatch;
+
+// Etapas medidas hasta predictedDisplayTime
+enum LatencyStage : uint32_t {
+    kLatencyInputToPhoton = 0,    // Muestreo de input (xrSyncActions)
+    kLatencyPoseToPhoton = 1,     // Localización de poses (último xrLocateViews)
+    kLatencySubmitToPhoton = 2,   // Envío a la GPU (antes de xrEndFrame)
+    kLatencyStageCount = 3
+};
+
+// Histograma de latencias con cubetas fijas de 0.5 ms; la última acumula el desbordamiento
+struct LatencyHistogram {
+    static constexpr uint32_t kBucketCount = 80;
+    static constexpr int64_t kBucketWidthNs = 500000;
+
+    uint32_t buckets[kBucketCount] = {};
+    uint64_t count = 0;
+    int64_t sumNs = 0;
+    int64_t maxNs = 0;
+
+    void add(int64_t latencyNs);
+};
+
+// Instrumentación de latencia input-to-photon. Todas las marcas se toman con
+// CLOCK_MONOTONIC y se pasan al dominio XrTime con XR_KHR_convert_timespec_time,
+// de modo que se comparan directamente con predictedDisplayTime.
+struct LatencyTracker {
+    PFN_xrConvertTimespecTimeToTimeKHR convertTimespecTime = nullptr;
+    XrInstance instance = XR_NULL_HANDLE;
+
+    bool initialize(const XrDispatch& dispatch, XrInstance xrInstance);
+    void destroy();
+    bool isAvailable() const { return convertTimespecTime != nullptr; }
+
+    // Marcas del frame en curso
+    void beginFrame();
+    void mark(LatencyStage stage);
+    void endFrame(XrTime predictedDisplayTime);
+
+    // Formato plano para JNI: [stageCount, bucketCount, bucketWidthNs,
+    //  y por etapa: count, sumNs, maxNs, buckets...]
+    void exportHistograms(std::vector<int64_t>& out);
+    void reset();
+
+private:
+    int64_t monotonicNowNs() const;
+
+    // Desplazamiento CLOCK_MONOTONIC -> XrTime, recalculado una vez por frame
+    int64_t clockOffsetNs = 0;
+    bool frameOpen = false;
+    int64_t marksNs[kLatencyStageCount] = {};
+    bool marked[kLatencyStageCount] = {};
+
+    std::mutex histogramMutex;   // JNI lee desde el hilo de UI
+    LatencyHistogram histograms[kLatencyStageCount];
+};
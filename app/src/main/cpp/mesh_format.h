@@ -0,0 +1,93 @@
+#pragma once
+
+// Formato binario de mallas (.hmesh). Este header lo comparten la app y la
+// herramienta de host tools/meshconv, así que no debe depender de Android ni de GL.
+//
+// Disposición del archivo (little-endian):
+//   MeshFileHeader                      (16 bytes)
+//   MeshRecord[meshCount]               (tabla de cabeceras, 88 bytes cada una)
+//   blobs de vértices / índices         (cada uno alineado a 16 bytes)
+//
+// Los blobs se suben a GL directamente desde el archivo mapeado en memoria,
+// sin parsear ni copiar.
+
+#include <cstdint>
+
+constexpr uint32_t kMeshFileMagic = 0x48534D48;   // "HMSH"
+constexpr uint32_t kMeshFileVersion = 1;
+constexpr uint32_t kMeshBlobAlignment = 16;
+constexpr uint32_t kMeshNameSize = 32;
+
+// Atributos presentes en los vértices (entrelazados en este orden)
+enum MeshAttributeBits : uint32_t {
+    kMeshAttribPosition = 1u << 0,   // vec3 float
+    kMeshAttribNormal   = 1u << 1,   // vec3 float
+    kMeshAttribTexCoord = 1u << 2,   // vec2 float
+};
+
+struct MeshFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t meshCount;
+    uint32_t reserved;
+};
+
+struct MeshRecord {
+    char name[kMeshNameSize];
+    uint32_t attributes;     // MeshAttributeBits
+    uint32_t vertexStride;   // bytes por vértice
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t indexSize;      // 2 (uint16) o 4 (uint32); 0 si no hay índices
+    uint32_t reserved;
+    uint64_t vertexOffset;   // desde el inicio del archivo
+    uint64_t vertexBytes;
+    uint64_t indexOffset;
+    uint64_t indexBytes;
+};
+
+static_assert(sizeof(MeshFileHeader) == 16, "MeshFileHeader debe ocupar 16 bytes");
+static_assert(sizeof(MeshRecord) == 88, "MeshRecord debe ocupar 88 bytes");
+
+inline uint32_t meshVertexStride(uint32_t attributes) {
+    uint32_t stride = 0;
+    if (attributes & kMeshAttribPosition) stride += 3 * sizeof(float);
+    if (attributes & kMeshAttribNormal) stride += 3 * sizeof(float);
+    if (attributes & kMeshAttribTexCoord) stride += 2 * sizeof(float);
+    return stride;
+}
+
+// Rango [offset, offset + bytes) dentro del archivo. Los valores vienen del archivo:
+// se comprueba sin sumarlos para que un offset cercano a UINT64_MAX no desborde.
+inline bool meshRangeInFile(uint64_t offset, uint64_t bytes, uint64_t fileSize) {
+    return offset <= fileSize && bytes <= fileSize - offset;
+}
+
+// La cabecera y la tabla de registros caben en el archivo
+inline bool meshTableInFile(const MeshFileHeader& header, uint64_t fileSize) {
+    return meshRangeInFile(sizeof(MeshFileHeader), static_cast<uint64_t>(header.meshCount) * sizeof(MeshRecord),
+                           fileSize);
+}
+
+// Validación de un registro antes de usar sus blobs, común a la app y a meshconv.
+// Devuelve nullptr si es válido o la descripción del error.
+inline const char* validateMeshRecord(const MeshRecord& record, uint64_t fileSize) {
+    if (record.vertexStride != meshVertexStride(record.attributes) || !(record.attributes & kMeshAttribPosition)) {
+        return "formato de vértice inválido";
+    }
+    if (record.vertexOffset % kMeshBlobAlignment != 0 || record.indexOffset % kMeshBlobAlignment != 0) {
+        return "blobs no alineados";
+    }
+    if (record.vertexBytes != static_cast<uint64_t>(record.vertexCount) * record.vertexStride ||
+        !meshRangeInFile(record.vertexOffset, record.vertexBytes, fileSize)) {
+        return "blob de vértices fuera de rango";
+    }
+    if (record.indexCount > 0) {
+        if ((record.indexSize != 2 && record.indexSize != 4) ||
+            record.indexBytes != static_cast<uint64_t>(record.indexCount) * record.indexSize ||
+            !meshRangeInFile(record.indexOffset, record.indexBytes, fileSize)) {
+            return "blob de índices inválido";
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,138 @@
+#include "mesh_loader.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "asset_file.h"
+#include "mesh_format.h"
+#include "native_log.h"
+
+namespace {
+
+void setupVertexLayout(uint32_t attributes, GLsizei stride) {
+    uintptr_t offset = 0;
+    if (attributes & kMeshAttribPosition) {
+        glVertexAttribPointer(kPositionAttribLocation, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offset));
+        glEnableVertexAttribArray(kPositionAttribLocation);
+        offset += 3 * sizeof(float);
+    }
+    if (attributes & kMeshAttribNormal) {
+        glVertexAttribPointer(kNormalAttribLocation, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offset));
+        glEnableVertexAttribArray(kNormalAttribLocation);
+        offset += 3 * sizeof(float);
+    }
+    if (attributes & kMeshAttribTexCoord) {
+        glVertexAttribPointer(kTexCoordAttribLocation, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offset));
+        glEnableVertexAttribArray(kTexCoordAttribLocation);
+    }
+}
+
+} // namespace
+
+void GpuMesh::cleanup() {
+    if (vao != 0) {
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+    if (vertexBuffer != 0) {
+        glDeleteBuffers(1, &vertexBuffer);
+        vertexBuffer = 0;
+    }
+    if (indexBuffer != 0) {
+        glDeleteBuffers(1, &indexBuffer);
+        indexBuffer = 0;
+    }
+    vertexCount = indexCount = 0;
+    indexType = GL_NONE;
+}
+
+bool loadMeshAsset(AAssetManager* assetManager, const char* path, std::vector<GpuMesh>& outMeshes) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    MappedAsset file;
+    if (!file.open(assetManager, path)) {
+        return false;
+    }
+
+    if (file.size < sizeof(MeshFileHeader)) {
+        LOGE("Archivo de malla demasiado pequeño: %s", path);
+        return false;
+    }
+
+    // Copias locales de las cabeceras: el mmap no garantiza alineación para lecturas de 64 bits
+    MeshFileHeader header;
+    memcpy(&header, file.data, sizeof(header));
+    if (header.magic != kMeshFileMagic || header.version != kMeshFileVersion) {
+        LOGE("Malla %s con cabecera inválida (magic 0x%08x, versión %u)", path, header.magic, header.version);
+        return false;
+    }
+    if (!meshTableInFile(header, file.size)) {
+        LOGE("Tabla de mallas fuera de rango en %s", path);
+        return false;
+    }
+
+    const uint8_t* recordTable = file.data + sizeof(MeshFileHeader);
+    size_t uploadedBytes = 0;
+
+    for (uint32_t i = 0; i < header.meshCount; i++) {
+        MeshRecord record;
+        memcpy(&record, recordTable + i * sizeof(MeshRecord), sizeof(record));
+        if (const char* error = validateMeshRecord(record, file.size)) {
+            LOGE("Malla %u de %s descartada: %s", i, path, error);
+            continue;
+        }
+
+        GpuMesh mesh;
+        mesh.name.assign(record.name, strnlen(record.name, kMeshNameSize));
+        mesh.vertexCount = static_cast<GLsizei>(record.vertexCount);
+
+        glGenVertexArrays(1, &mesh.vao);
+        glBindVertexArray(mesh.vao);
+
+        // Subida directa desde el archivo mapeado
+        glGenBuffers(1, &mesh.vertexBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(record.vertexBytes),
+                     file.data + record.vertexOffset, GL_STATIC_DRAW);
+        setupVertexLayout(record.attributes, static_cast<GLsizei>(record.vertexStride));
+        uploadedBytes += record.vertexBytes;
+
+        if (record.indexCount > 0) {
+            glGenBuffers(1, &mesh.indexBuffer);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBuffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(record.indexBytes),
+                         file.data + record.indexOffset, GL_STATIC_DRAW);
+            mesh.indexCount = static_cast<GLsizei>(record.indexCount);
+            mesh.indexType = record.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+            uploadedBytes += record.indexBytes;
+        }
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        outMeshes.push_back(mesh);
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    LOGI("✓ %s: %u mallas, %zu bytes subidos en %.3f ms", path, header.meshCount, uploadedBytes, elapsedMs);
+    return !outMeshes.empty();
+}
+
+bool createPositionMesh(const char* name, const float* positions, GLsizei vertexCount, GpuMesh& outMesh) {
+    outMesh.cleanup();
+    outMesh.name = name;
+    outMesh.vertexCount = vertexCount;
+
+    glGenVertexArrays(1, &outMesh.vao);
+    glGenBuffers(1, &outMesh.vertexBuffer);
+
+    glBindVertexArray(outMesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, outMesh.vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * 3 * sizeof(float), positions, GL_STATIC_DRAW);
+    setupVertexLayout(kMeshAttribPosition, 3 * sizeof(float));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return glGetError() == GL_NO_ERROR;
+}
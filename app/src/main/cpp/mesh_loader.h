@@ -0,0 +1,31 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <android/asset_manager.h>
+#include <string>
+#include <vector>
+
+// Ubicaciones fijas de atributos (layout(location = N) en los shaders)
+constexpr GLuint kPositionAttribLocation = 0;
+constexpr GLuint kNormalAttribLocation = 1;
+constexpr GLuint kTexCoordAttribLocation = 2;
+
+// Malla residente en GPU
+struct GpuMesh {
+    std::string name;
+    GLuint vao = 0;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+    GLsizei vertexCount = 0;
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_NONE;
+
+    void cleanup();
+};
+
+// Carga todas las mallas de un archivo .hmesh del APK (ver mesh_format.h).
+// El archivo se mapea en memoria y los blobs se pasan tal cual a glBufferData.
+bool loadMeshAsset(AAssetManager* assetManager, const char* path, std::vector<GpuMesh>& outMeshes);
+
+// Sube una malla de posiciones sin índices (geometría de respaldo integrada)
+bool createPositionMesh(const char* name, const float* positions, GLsizei vertexCount, GpuMesh& outMesh);
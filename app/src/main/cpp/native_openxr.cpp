@@ -2,8 +2,10 @@
 #include <android/log.h>
 #include <android/native_window.h>
 #include <android/native_window_jni.h>
+#include <android/asset_manager_jni.h>
 #include <GLES3/gl3.h>
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <openxr/openxr.h>
 #include <openxr/openxr_platform.h>
 #include <vector>
@@ -12,17 +14,43 @@
 #include <cstring>
 #include <memory>
 #include <mutex>
-
-#define LOG_TAG "OpenXRHolaMundo"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <atomic>
+
+#include "draw_packets.h"
+#include "foveation.h"
+#include "frame_arena.h"
+#include "gl_state_cache.h"
+#include "gpu_timer.h"
+#include "hand_tracking.h"
+#include "job_system.h"
+#include "late_latch.h"
+#include "latency_tracker.h"
+#include "mesh_loader.h"
+#include "native_log.h"
+#include "passthrough.h"
+#include "pose_service.h"
+#include "render_queue.h"
+#include "swapchain_format.h"
+#include "swapchain_pool.h"
+#include "texture_streamer.h"
+#include "thread_registry.h"
+#include "uniform_ring.h"
+#include "upload_worker.h"
+#include "xr_capabilities.h"
+#include "xr_check.h"
+#include "xr_dispatch.h"
+#include "xr_input.h"
+#include "xr_math.h"
 
 // Estructura para manejar el estado de OpenXR de forma más organizada
 struct OpenXRState {
     XrInstance instance = XR_NULL_HANDLE;
     XrSession session = XR_NULL_HANDLE;
     XrSpace appSpace = XR_NULL_HANDLE;
+    XrSpace viewSpace = XR_NULL_HANDLE;     // Pose de la cabeza para el servicio de poses
     XrSystemId systemId = XR_NULL_SYSTEM_ID;
     XrSessionState sessionState = XR_SESSION_STATE_UNKNOWN;
 
@@ -35,6 +63,12 @@ struct OpenXRState {
     EGLDisplay eglDisplay = EGL_NO_DISPLAY;
     EGLContext eglContext = EGL_NO_CONTEXT;
     EGLConfig eglConfig = nullptr;
+    EGLSurface eglSurface = EGL_NO_SURFACE;   // Pbuffer 1x1 solo si no hay EGL_KHR_surfaceless_context
+
+    // Contexto de GLSurfaceView: se restaura tras cada llamada nativa para que pueda hacer swap
+    EGLContext hostContext = EGL_NO_CONTEXT;
+    EGLSurface hostDrawSurface = EGL_NO_SURFACE;
+    EGLSurface hostReadSurface = EGL_NO_SURFACE;
 
     bool isInitialized = false;
     bool isSessionCreated = false;
@@ -46,11 +80,17 @@ struct OpenXRState {
     void reset() {
         std::lock_guard<std::mutex> lock(stateMutex);
 
-        // Limpiar recursos EGL - SIN superficie
+        // Limpiar recursos EGL - SIN superficie de ventana
         if (eglContext != EGL_NO_CONTEXT) {
             eglDestroyContext(eglDisplay, eglContext);
             eglContext = EGL_NO_CONTEXT;
         }
+        if (eglSurface != EGL_NO_SURFACE) {
+            eglDestroySurface(eglDisplay, eglSurface);
+            eglSurface = EGL_NO_SURFACE;
+        }
+        hostContext = EGL_NO_CONTEXT;
+        hostDrawSurface = hostReadSurface = EGL_NO_SURFACE;
         if (eglDisplay != EGL_NO_DISPLAY) {
             eglTerminate(eglDisplay);
             eglDisplay = EGL_NO_DISPLAY;
@@ -61,6 +101,7 @@ struct OpenXRState {
         instance = XR_NULL_HANDLE;
         session = XR_NULL_HANDLE;
         appSpace = XR_NULL_HANDLE;
+        viewSpace = XR_NULL_HANDLE;
         systemId = XR_NULL_SYSTEM_ID;
         sessionState = XR_SESSION_STATE_UNKNOWN;
         javaVm = nullptr;
@@ -72,31 +113,175 @@ struct OpenXRState {
     }
 };
 
-// Información de swapchain mejorada
-struct SwapchainInfo {
-    XrSwapchain swapchain = XR_NULL_HANDLE;
-    uint32_t width = 0;
-    uint32_t height = 0;
-    std::vector<XrSwapchainImageOpenGLESKHR> images;
-
-    void cleanup() {
-        if (swapchain != XR_NULL_HANDLE) {
-            xrDestroySwapchain(swapchain);
-            swapchain = XR_NULL_HANDLE;
-        }
-        images.clear();
-        width = height = 0;
-    }
-};
-
 // Variables globales
 static OpenXRState g_openxrState;
-static std::vector<SwapchainInfo> g_swapchains;
+// Swapchains de la sesión actual, prestados por el pool
+static SwapchainPool g_swapchainPool;
+static std::vector<SwapchainInfo*> g_swapchains;
 static XrViewConfigurationView g_viewConfigs[2];
 static GLuint g_shaderProgram = 0;
-static GLuint g_VAO = 0;
-static GLuint g_VBO = 0;
+static std::vector<GpuMesh> g_sceneMeshes;
+static TextureHandle g_sceneTexture = kInvalidTexture;
+static GLuint g_whiteTexture = 0;   // Sustituto mientras no haya textura de escena
 static bool g_shadersInitialized = false;
+static AAssetManager* g_assetManager = nullptr;
+static jobject g_assetManagerRef = nullptr;
+static UniformRing g_uniformRing;
+static TextureStreamer g_textureStreamer;
+static UploadWorker g_uploadWorker;
+static XrInput g_input;
+static PoseService g_poseService;
+static HandTracking g_handTracking;
+static LateLatchBuffer g_lateLatch;
+static bool g_lateLatchRequested = true;
+
+// Edad de las poses al enviar el frame, con y sin late latching (media móvil en ms)
+struct PoseLatencyStats {
+    double earlyPoseAgeMs = 0.0;   // Desde el primer xrLocateViews
+    double latePoseAgeMs = 0.0;    // Desde el xrLocateViews tardío
+    uint64_t frames = 0;
+    uint64_t latchedFrames = 0;
+};
+static PoseLatencyStats g_poseLatency;
+constexpr uint64_t kPoseLatencyLogInterval = 900;
+
+static FoveationController g_foveation;
+static GpuTimer g_gpuTimer;
+static std::vector<XrSwapchain> g_swapchainHandles;   // Para xrUpdateSwapchainFB
+static uint64_t g_gpuTimedFrames = 0;
+constexpr uint32_t kGpuTimerQueries = 8;
+
+static Passthrough g_passthrough;
+static bool g_passthroughRequested = false;
+
+static LatencyTracker g_latency;
+
+// Hilos críticos (render, workers) comunicados al runtime y, en benchmarks, fijados en el host
+static ThreadRegistry g_threadRegistry;
+
+// Trabajo de CPU del frame repartido en los núcleos grandes; el grafo se construye
+// una vez y sus tareas leen el tiempo predicho del frame en curso
+static JobSystem g_jobs;
+static FrameTaskGraph g_frameGraph;
+static XrTime g_frameGraphTime = 0;
+// Draws grabados como paquetes (en workers si hay suficientes) y reproducidos en el hilo GL
+static DrawPacketRecorder g_drawPackets;
+// Sombra del estado GL del contexto dedicado para el render de los ojos
+static GlStateCache g_glState;
+
+// Funciones de extensión resueltas una vez por instancia
+static XrDispatch g_xrDispatch;
+// Extensiones habilitadas en la instancia y bitset de funcionalidades
+static XrCapabilities g_capabilities;
+
+// Espacios registrados en el servicio de poses
+static PoseSpaceId g_headPoseId = kInvalidPoseSpace;
+
+// Tamaño de cada slot del anillo UBO (datos de vista + datos por draw de un frame)
+constexpr GLsizeiptr kUniformSlotSize = 64 * 1024;
+// Datos transitorios del frame (listas de capas, vistas...) sin pasar por el heap
+static FrameArenas g_frameArenas;
+constexpr size_t kFrameArenaBytes = 256 * 1024;
+constexpr size_t kWorkerArenaBytes = 64 * 1024;
+// Planos de recorte para la proyección de cada ojo
+constexpr float kNearZ = 0.05f;
+constexpr float kFarZ = 100.0f;
+// Malla de la escena dentro del APK (formato .hmesh, ver mesh_format.h)
+constexpr const char* kSceneMeshAsset = "meshes/quad.hmesh";
+// Textura de la escena (KTX2 ASTC 4x4, un color distinto por mip para ver el streaming)
+constexpr const char* kSceneTextureAsset = "textures/checker.ktx2";
+constexpr GLuint kSceneTextureUnit = 0;
+// Presupuestos del streaming de texturas ASTC
+constexpr uint64_t kTextureGpuBudget = 128ull * 1024 * 1024;
+constexpr uint64_t kTextureUploadBudgetPerFrame = 1ull * 1024 * 1024;
+
+// Desglose del arranque (ms desde nativeInitialize). En caliente solo se mide
+// hasta el primer frame, para compararlo con el del arranque en frío.
+struct StartupTimings {
+    std::chrono::steady_clock::time_point begin;
+    double loaderMs = 0.0;
+    double discoveryMs = 0.0;      // Hilo: runtime, extensiones, instancia, sistema
+    double prefetchMs = 0.0;       // Hilo: precarga de assets
+    double eglMs = 0.0;            // Hilo GL: contexto dedicado
+    double resourcesMs = 0.0;      // Hilo GL: shaders, geometría, texturas
+    double discoveryWaitMs = 0.0;  // Hilo GL bloqueado esperando al descubrimiento
+    double sessionMs = 0.0;
+    bool warm = false;             // Reanudación con instancia, EGL y recursos conservados
+    bool firstFrameLogged = false;
+};
+static StartupTimings g_startupTimings;
+static double g_coldFirstFrameMs = 0.0;
+static std::future<bool> g_discoveryResult;
+static std::future<void> g_assetPrefetch;
+
+// Assets que se leen al arrancar; se precargan en la caché de páginas en paralelo
+static const char* const kPrefetchAssets[] = {kSceneMeshAsset, kSceneTextureAsset};
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Activa el contexto dedicado en el hilo actual (no-op si ya lo está)
+bool makeNativeContextCurrent() {
+    if (g_openxrState.eglContext == EGL_NO_CONTEXT) {
+        return false;
+    }
+    EGLContext current = eglGetCurrentContext();
+    if (current == g_openxrState.eglContext) {
+        return true;
+    }
+    // GLSurfaceView puede recrear su contexto tras una pausa: recordar el actual en cada cambio
+    g_openxrState.hostContext = current;
+    g_openxrState.hostDrawSurface = eglGetCurrentSurface(EGL_DRAW);
+    g_openxrState.hostReadSurface = eglGetCurrentSurface(EGL_READ);
+    if (!eglMakeCurrent(g_openxrState.eglDisplay, g_openxrState.eglSurface,
+                        g_openxrState.eglSurface, g_openxrState.eglContext)) {
+        LOGE("eglMakeCurrent del contexto dedicado falló: 0x%X", eglGetError());
+        return false;
+    }
+    return true;
+}
+
+// Devuelve el hilo al contexto de GLSurfaceView, que hace eglSwapBuffers tras onDrawFrame
+void restoreHostContext() {
+    if (g_openxrState.hostContext == EGL_NO_CONTEXT || eglGetCurrentContext() == g_openxrState.hostContext) {
+        return;
+    }
+    eglMakeCurrent(g_openxrState.eglDisplay, g_openxrState.hostDrawSurface,
+                   g_openxrState.hostReadSurface, g_openxrState.hostContext);
+}
+
+struct ScopedHostContextRestore {
+    ~ScopedHostContextRestore() { restoreHostContext(); }
+};
+
+// Recuperación ante pérdida de sesión o instancia. CheckXrResult y los eventos
+// piden el nivel necesario; nativeRunFrame reconstruye sin reiniciar la app.
+enum XrRecoveryLevel : int {
+    kRecoveryNone = 0,
+    kRecoverySession = 1,    // Sesión, espacios y swapchains
+    kRecoveryInstance = 2,   // Además instancia y sistema
+};
+
+struct RecoveryState {
+    std::atomic<int> requested{kRecoveryNone};   // Puede pedirse desde cualquier hilo
+    int level = kRecoveryNone;                   // En curso (solo hilo GL)
+    uint32_t attempts = 0;
+    std::chrono::milliseconds backoff{0};
+    std::chrono::steady_clock::time_point lostAt;
+    std::chrono::steady_clock::time_point nextAttempt;
+};
+static RecoveryState g_recovery;
+static std::atomic<int> g_injectedFault{kRecoveryNone};
+
+constexpr std::chrono::milliseconds kRecoveryInitialBackoff{250};
+constexpr std::chrono::milliseconds kRecoveryMaxBackoff{4000};
+
+static void requestRecovery(XrRecoveryLevel level) {
+    int current = g_recovery.requested.load();
+    while (current < level && !g_recovery.requested.compare_exchange_weak(current, level)) {
+    }
+}
 
 // Función mejorada para verificar resultados
 bool CheckXrResult(XrResult result, const char* operation) {
@@ -106,10 +291,12 @@ bool CheckXrResult(XrResult result, const char* operation) {
         // Proporcionar información más detallada sobre errores comunes
         switch (result) {
             case XR_ERROR_INSTANCE_LOST:
-                LOGE("  -> Instance lost - needs recreation");
+                LOGE("  -> Instance lost - recreando instancia y sesión");
+                requestRecovery(kRecoveryInstance);
                 break;
             case XR_ERROR_SESSION_LOST:
-                LOGE("  -> Session lost - needs recreation");
+                LOGE("  -> Session lost - recreando sesión");
+                requestRecovery(kRecoverySession);
                 break;
             case XR_ERROR_RUNTIME_FAILURE:
                 LOGE("  -> Runtime failure - check Oculus service");
@@ -169,53 +356,6 @@ bool initializeOpenXRLoader(JNIEnv* env, jobject activityObject) {
     return true;
 }
 
-// Función para verificar extensiones con mejor logging
-bool verifyRequiredExtensions() {
-    LOGI("Verificando extensiones OpenXR disponibles...");
-
-    uint32_t extensionCount = 0;
-    if (!CheckXrResult(xrEnumerateInstanceExtensionProperties(nullptr, 0, &extensionCount, nullptr),
-                       "xrEnumerateInstanceExtensionProperties (count)")) {
-        return false;
-    }
-
-    LOGI("Encontradas %d extensiones disponibles", extensionCount);
-
-    std::vector<XrExtensionProperties> availableExtensions(extensionCount, {XR_TYPE_EXTENSION_PROPERTIES});
-    if (!CheckXrResult(xrEnumerateInstanceExtensionProperties(nullptr, extensionCount, &extensionCount, availableExtensions.data()),
-                       "xrEnumerateInstanceExtensionProperties (data)")) {
-        return false;
-    }
-
-    // Verificar extensiones requeridas
-    bool androidExtensionAvailable = false;
-    bool openglExtensionAvailable = false;
-
-    for (const auto& ext : availableExtensions) {
-        if (strcmp(ext.extensionName, XR_KHR_ANDROID_CREATE_INSTANCE_EXTENSION_NAME) == 0) {
-            androidExtensionAvailable = true;
-            LOGI("✓ Extensión Android CREATE_INSTANCE encontrada");
-        }
-        if (strcmp(ext.extensionName, XR_KHR_OPENGL_ES_ENABLE_EXTENSION_NAME) == 0) {
-            openglExtensionAvailable = true;
-            LOGI("✓ Extensión OpenGL ES encontrada");
-        }
-    }
-
-    if (!androidExtensionAvailable) {
-        LOGE("✗ Extensión Android CREATE_INSTANCE no disponible");
-        return false;
-    }
-
-    if (!openglExtensionAvailable) {
-        LOGE("✗ Extensión OpenGL ES no disponible");
-        return false;
-    }
-
-    LOGI("✓ Todas las extensiones requeridas están disponibles");
-    return true;
-}
-
 // Función auxiliar para compilar shaders
 bool compileShader(GLuint shader, const char* source) {
     glShaderSource(shader, 1, &source, nullptr);
@@ -240,19 +380,35 @@ bool initializeShaders() {
 
     LOGI("Inicializando shaders...");
 
+    // Los datos uniformes llegan por UBO (ver UniformRing), sin glUniform* por draw
     const char* vertexShaderSource =
             "#version 300 es\n"
-            "in vec3 aPosition;\n"
+            "layout(std140) uniform ViewData {\n"
+            "    mat4 viewProj;\n"
+            "};\n"
+            "layout(std140) uniform DrawData {\n"
+            "    mat4 model;\n"
+            "    vec4 color;\n"
+            "};\n"
+            "layout(location = 0) in vec3 aPosition;\n"
+            "layout(location = 2) in vec2 aTexCoord;\n"
+            "flat out vec4 vColor;\n"
+            "out vec2 vTexCoord;\n"
             "void main() {\n"
-            "    gl_Position = vec4(aPosition, 1.0);\n"
+            "    vColor = color;\n"
+            "    vTexCoord = aTexCoord;\n"
+            "    gl_Position = viewProj * model * vec4(aPosition, 1.0);\n"
             "}\n";
 
     const char* fragmentShaderSource =
             "#version 300 es\n"
             "precision mediump float;\n"
+            "uniform sampler2D uTexture;\n"
+            "flat in vec4 vColor;\n"
+            "in vec2 vTexCoord;\n"
             "out vec4 fragColor;\n"
             "void main() {\n"
-            "    fragColor = vec4(0.0, 1.0, 0.0, 1.0);\n"
+            "    fragColor = vColor * texture(uTexture, vTexCoord);\n"
             "}\n";
 
     // Compilar vertex shader
@@ -286,6 +442,7 @@ bool initializeShaders() {
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
         glDeleteProgram(g_shaderProgram);
+        g_shaderProgram = 0;
         return false;
     }
 
@@ -293,7 +450,44 @@ bool initializeShaders() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    // Crear geometría del rectángulo
+    // Asociar los bloques uniformes a sus puntos de binding fijos
+    GLuint viewBlockIndex = glGetUniformBlockIndex(g_shaderProgram, "ViewData");
+    GLuint drawBlockIndex = glGetUniformBlockIndex(g_shaderProgram, "DrawData");
+    if (viewBlockIndex == GL_INVALID_INDEX || drawBlockIndex == GL_INVALID_INDEX) {
+        LOGE("No se encontraron los bloques uniformes ViewData/DrawData");
+        return false;
+    }
+    glUniformBlockBinding(g_shaderProgram, viewBlockIndex, kViewUniformBinding);
+    glUniformBlockBinding(g_shaderProgram, drawBlockIndex, kDrawUniformBinding);
+    glUseProgram(g_shaderProgram);
+    glUniform1i(glGetUniformLocation(g_shaderProgram, "uTexture"), kSceneTextureUnit);
+    glUseProgram(0);
+
+    // Blanco 1x1: la geometría sin textura (o sin ASTC) se ve con su color
+    const uint8_t white[4] = {255, 255, 255, 255};
+    glGenTextures(1, &g_whiteTexture);
+    glBindTexture(GL_TEXTURE_2D, g_whiteTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // El streaming de texturas es opcional: sin ASTC la escena sigue sin texturas
+    if (!g_textureStreamer.initialize(kTextureGpuBudget, kTextureUploadBudgetPerFrame)) {
+        LOGE("Streaming de texturas deshabilitado");
+    } else {
+        // Mips pequeños al instante; el resto llega por update() dentro del presupuesto
+        g_sceneTexture = g_textureStreamer.load(g_assetManager, kSceneTextureAsset);
+    }
+
+    // Cargar la geometría desde el APK; si no está, usar el rectángulo integrado
+    if (loadMeshAsset(g_assetManager, kSceneMeshAsset, g_sceneMeshes)) {
+        g_shadersInitialized = true;
+        LOGI("✓ Shaders inicializados correctamente");
+        return true;
+    }
+    LOGI("Usando geometría integrada (sin %s)", kSceneMeshAsset);
+
     float vertices[] = {
             // Rectángulo simple centrado
             -0.5f, -0.3f, 0.0f,  // Inferior izquierdo
@@ -305,150 +499,457 @@ bool initializeShaders() {
             -0.5f,  0.3f, 0.0f   // Superior izquierdo
     };
 
-    glGenVertexArrays(1, &g_VAO);
-    glGenBuffers(1, &g_VBO);
-
-    glBindVertexArray(g_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, g_VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    GLint positionAttrib = glGetAttribLocation(g_shaderProgram, "aPosition");
-    if (positionAttrib == -1) {
-        LOGE("No se pudo encontrar atributo aPosition");
+    GpuMesh quad;
+    if (!createPositionMesh("quad", vertices, 6, quad)) {
+        LOGE("No se pudo crear la geometría integrada");
         return false;
     }
-
-    glVertexAttribPointer(positionAttrib, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(positionAttrib);
-
-    glBindVertexArray(0);
+    g_sceneMeshes.push_back(quad);
 
     g_shadersInitialized = true;
     LOGI("✓ Shaders inicializados correctamente");
     return true;
 }
 
+// Programa y geometría de la escena; requiere el contexto dedicado activo
+static void releaseSceneResources() {
+    if (g_shaderProgram != 0) {
+        glDeleteProgram(g_shaderProgram);
+        g_shaderProgram = 0;
+    }
+    for (GpuMesh& mesh : g_sceneMeshes) {
+        mesh.cleanup();
+    }
+    g_sceneMeshes.clear();
+    if (g_whiteTexture != 0) {
+        glDeleteTextures(1, &g_whiteTexture);
+        g_whiteTexture = 0;
+    }
+    g_sceneTexture = kInvalidTexture;   // La libera g_textureStreamer.cleanup()
+    g_shadersInitialized = false;
+}
+
 // Función para limpiar recursos de forma segura
 void cleanupSwapchains() {
     LOGI("Limpiando swapchains...");
-    for (auto& swapchain : g_swapchains) {
-        swapchain.cleanup();
+    for (SwapchainInfo* swapchain : g_swapchains) {
+        g_swapchainPool.release(swapchain);
     }
     g_swapchains.clear();
+    // Los swapchains mueren con la sesión; el pool conserva framebuffers y formatos
+    if (g_openxrState.session != XR_NULL_HANDLE) {
+        g_swapchainPool.releaseSession(g_openxrState.session);
+    }
 }
 
-extern "C" JNIEXPORT jboolean JNICALL
-Java_com_example_holamundo2_MainActivity_nativeInitialize(JNIEnv *env, jobject thiz) {
-    LOGI("=== Inicializando OpenXR ===");
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeSetAssetManager(JNIEnv *env, jobject thiz, jobject assetManager) {
+    // Mantener viva la referencia Java mientras se use el AAssetManager nativo
+    if (g_assetManagerRef) {
+        env->DeleteGlobalRef(g_assetManagerRef);
+    }
+    g_assetManagerRef = env->NewGlobalRef(assetManager);
+    g_assetManager = AAssetManager_fromJava(env, g_assetManagerRef);
+    LOGI("AAssetManager configurado: %p", g_assetManager);
+}
 
-    // Reset del estado
-    g_openxrState.reset();
-    cleanupSwapchains();
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeSetLateLatching(JNIEnv *env, jobject thiz, jboolean enabled) {
+    // Se aplica al crear la sesión; con la sesión ya creada solo puede desactivarse
+    g_lateLatchRequested = enabled == JNI_TRUE;
+    LOGI("Late latching %s", g_lateLatchRequested ? "solicitado" : "desactivado");
+}
 
-    try {
-        // 1. Inicializar Loader OpenXR
-        LOGI("=== VERIFICANDO DISPONIBILIDAD DE OPENXR ===");
-        if (!initializeOpenXRLoader(env, thiz)) {
-            LOGE("FALLO: OpenXR no está disponible");
-            return JNI_FALSE;
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeSetFoveationMode(JNIEnv *env, jobject thiz, jint mode) {
+    if (mode < 0 || mode >= static_cast<jint>(kFoveationModeCount)) {
+        LOGE("Modo de foveation inválido: %d", mode);
+        return;
+    }
+    // Se aplica en el siguiente frame; eye-tracked cae a fija si no está disponible
+    g_foveation.setMode(static_cast<FoveationMode>(mode));
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeSetPassthrough(JNIEnv *env, jobject thiz, jboolean enabled) {
+    // Se aplica en el siguiente frame; sin XR_FB_passthrough se sigue renderizando opaco
+    g_passthroughRequested = enabled == JNI_TRUE;
+    LOGI("Passthrough %s", g_passthroughRequested ? "solicitado" : "desactivado");
+}
+
+// Benchmarks: afinidad y nice por papel de hilo; se aplica también a los ya registrados
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeSetThreadPinning(JNIEnv *env, jobject thiz, jboolean enabled) {
+    g_threadRegistry.setHostPinning(enabled == JNI_TRUE);
+}
+
+// Escalado del job system de 1 a N hilos en el host (solo logs; bloquea el hilo que llama)
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeRunJobBenchmark(JNIEnv *env, jobject thiz) {
+    runJobSystemBenchmark();
+}
+
+// Grabación de draw packets de 1 a N hilos en el host (solo logs; bloquea el hilo que llama)
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeRunDrawBenchmark(JNIEnv *env, jobject thiz) {
+    runDrawPacketBenchmark();
+}
+
+// Ordenación de la cola de render de 1k a 1M paquetes (solo logs; bloquea el hilo que llama)
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeRunSortBenchmark(JNIEnv *env, jobject thiz) {
+    runRenderQueueBenchmark();
+}
+
+// Simula XR_ERROR_SESSION_LOST / XR_ERROR_INSTANCE_LOST en el siguiente frame
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_holamundo2_MainActivity_nativeInjectXrLoss(JNIEnv *env, jobject thiz, jboolean instanceLoss) {
+    LOGI("Inyectando pérdida de %s", instanceLoss ? "instancia" : "sesión");
+    g_injectedFault = instanceLoss ? kRecoveryInstance : kRecoverySession;
+}
+
+extern "C" JNIEXPORT jlongArray JNICALL
+Java_com_example_holamundo2_MainActivity_nativeGetLatencyHistograms(JNIEnv *env, jobject thiz) {
+    // Formato documentado en LatencyTracker::exportHistograms
+    std::vector<int64_t> data;
+    g_latency.exportHistograms(data);
+
+    jlongArray result = env->NewLongArray(static_cast<jint>(data.size()));
+    if (result) {
+        env->SetLongArrayRegion(result, 0, static_cast<jint>(data.size()), reinterpret_cast<const jlong*>(data.data()));
+    }
+    return result;
+}
+
+// Pasos 2-8 del arranque: runtime, extensiones, instancia, sistema y vistas.
+// Se ejecuta en un hilo propio mientras el hilo GL prepara EGL y los recursos.
+static bool discoverInstanceAndSystem() {
+    // 2. Verificar runtime
+    LOGI("=== VERIFICANDO RUNTIME OPENXR ===");
+    uint32_t testCount = 0;
+    XrResult testResult = xrEnumerateApiLayerProperties(0, &testCount, nullptr);
+    if (testResult != XR_SUCCESS && testResult != XR_ERROR_SIZE_INSUFFICIENT) {
+        LOGE("FALLO: Runtime OpenXR no responde (resultado: %d)", testResult);
+        return false;
+    }
+    LOGI("✓ Runtime OpenXR responde correctamente");
+
+    // 3-4. Resolver extensiones requeridas y opcionales
+    LOGI("=== VERIFICANDO EXTENSIONES ===");
+    if (!g_capabilities.resolve()) {
+        LOGE("FALLO: Extensiones requeridas no están disponibles");
+        return false;
+    }
+    const std::vector<const char*>& extensions = g_capabilities.enabledExtensions();
+
+    // 5. Crear instancia
+    XrInstanceCreateInfoAndroidKHR androidCreateInfo{XR_TYPE_INSTANCE_CREATE_INFO_ANDROID_KHR};
+    androidCreateInfo.applicationVM = g_openxrState.javaVm;
+    androidCreateInfo.applicationActivity = g_openxrState.activityObject;
+
+    XrInstanceCreateInfo instanceInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+    strncpy(instanceInfo.applicationInfo.applicationName, "HolaMundo VR", XR_MAX_APPLICATION_NAME_SIZE - 1);
+    instanceInfo.applicationInfo.applicationName[XR_MAX_APPLICATION_NAME_SIZE - 1] = '\0';
+    strncpy(instanceInfo.applicationInfo.engineName, "Custom Engine", XR_MAX_ENGINE_NAME_SIZE - 1);
+    instanceInfo.applicationInfo.engineName[XR_MAX_ENGINE_NAME_SIZE - 1] = '\0';
+    instanceInfo.applicationInfo.applicationVersion = 1;
+    instanceInfo.applicationInfo.engineVersion = 1;
+    instanceInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+    instanceInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    instanceInfo.enabledExtensionNames = extensions.data();
+    instanceInfo.next = &androidCreateInfo;
+
+    LOGI("Creando instancia OpenXR...");
+    if (!CheckXrResult(xrCreateInstance(&instanceInfo, &g_openxrState.instance), "xrCreateInstance")) {
+        return false;
+    }
+    LOGI("✓ Instancia OpenXR creada correctamente");
+
+    g_xrDispatch.load(g_openxrState.instance);
+    g_latency.initialize(g_xrDispatch, g_openxrState.instance);
+
+    // 6. Obtener propiedades del runtime
+    XrInstanceProperties instanceProperties{XR_TYPE_INSTANCE_PROPERTIES};
+    if (CheckXrResult(xrGetInstanceProperties(g_openxrState.instance, &instanceProperties), "xrGetInstanceProperties")) {
+        LOGI("Runtime: %s v%d.%d.%d",
+             instanceProperties.runtimeName,
+             XR_VERSION_MAJOR(instanceProperties.runtimeVersion),
+             XR_VERSION_MINOR(instanceProperties.runtimeVersion),
+             XR_VERSION_PATCH(instanceProperties.runtimeVersion));
+    }
+
+    // 7. Obtener sistema HMD
+    XrSystemGetInfo systemInfo{XR_TYPE_SYSTEM_GET_INFO};
+    systemInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+
+    LOGI("Obteniendo sistema HMD...");
+    if (!CheckXrResult(xrGetSystem(g_openxrState.instance, &systemInfo, &g_openxrState.systemId), "xrGetSystem")) {
+        LOGE("No se pudo encontrar un HMD compatible");
+        return false;
+    }
+    LOGI("✓ Sistema HMD encontrado (ID: %llu)", (unsigned long long)g_openxrState.systemId);
+
+    // 8. Verificar configuración de vista
+    uint32_t viewCount = 0;
+    XrViewConfigurationView viewConfigs[2] = {{XR_TYPE_VIEW_CONFIGURATION_VIEW}, {XR_TYPE_VIEW_CONFIGURATION_VIEW}};
+
+    if (!CheckXrResult(xrEnumerateViewConfigurationViews(g_openxrState.instance, g_openxrState.systemId,
+                                                         XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO, 2, &viewCount, viewConfigs),
+                       "xrEnumerateViewConfigurationViews")) {
+        return false;
+    }
+
+    if (viewCount != 2) {
+        LOGE("Se esperaban 2 vistas, pero se encontraron %d", viewCount);
+        return false;
+    }
+
+    // Guardar configuraciones de vista
+    memcpy(g_viewConfigs, viewConfigs, sizeof(g_viewConfigs));
+
+    LOGI("✓ Configuración de vista estéreo verificada:");
+    for (int i = 0; i < 2; i++) {
+        LOGI("  Ojo %d: %dx%d (recomendado), %dx%d (máximo)",
+             i,
+             g_viewConfigs[i].recommendedImageRectWidth, g_viewConfigs[i].recommendedImageRectHeight,
+             g_viewConfigs[i].maxImageRectWidth, g_viewConfigs[i].maxImageRectHeight);
+    }
+
+    g_openxrState.isInitialized = true;
+    LOGI("=== OpenXR inicializado correctamente ===");
+    return true;
+}
+
+// Lanza el descubrimiento de OpenXR en un hilo adjunto a la VM. Lo usan el arranque
+// y la recuperación tras perder la instancia.
+static void launchDiscovery() {
+    JavaVM* javaVm = g_openxrState.javaVm;
+    g_discoveryResult = std::async(std::launch::async, [javaVm]() {
+        // El runtime usa JNI al crear la instancia: el hilo debe estar adjunto a la VM
+        JNIEnv* threadEnv = nullptr;
+        const bool attached = javaVm && javaVm->AttachCurrentThread(&threadEnv, nullptr) == JNI_OK;
+
+        auto start = std::chrono::steady_clock::now();
+        bool success = false;
+        try {
+            success = discoverInstanceAndSystem();
+        } catch (const std::exception& e) {
+            LOGE("Excepción durante inicialización: %s", e.what());
+        } catch (...) {
+            LOGE("Excepción desconocida durante inicialización");
         }
+        g_startupTimings.discoveryMs = elapsedMs(start);
 
-        // 2. Verificar runtime
-        LOGI("=== VERIFICANDO RUNTIME OPENXR ===");
-        uint32_t testCount = 0;
-        XrResult testResult = xrEnumerateApiLayerProperties(0, &testCount, nullptr);
-        if (testResult != XR_SUCCESS && testResult != XR_ERROR_SIZE_INSUFFICIENT) {
-            LOGE("FALLO: Runtime OpenXR no responde (resultado: %d)", testResult);
-            return JNI_FALSE;
+        if (attached) {
+            javaVm->DetachCurrentThread();
         }
-        LOGI("✓ Runtime OpenXR responde correctamente");
+        return success;
+    });
+}
 
-        // 3. Verificar extensiones
-        LOGI("=== VERIFICANDO EXTENSIONES ===");
-        if (!verifyRequiredExtensions()) {
-            LOGE("FALLO: Extensiones requeridas no están disponibles");
-            return JNI_FALSE;
+static void startBackgroundStartup() {
+    launchDiscovery();
+
+    g_assetPrefetch = std::async(std::launch::async, []() {
+        auto start = std::chrono::steady_clock::now();
+        for (const char* path : kPrefetchAssets) {
+            MappedAsset asset;
+            if (asset.open(g_assetManager, path)) {
+                asset.prefetch();
+            }
+        }
+        g_startupTimings.prefetchMs = elapsedMs(start);
+    });
+}
+
+// Espera a las tareas de arranque pendientes (también en shutdown o si se reinicializa)
+static bool waitForBackgroundStartup() {
+    bool success = g_openxrState.isInitialized;
+    if (g_discoveryResult.valid()) {
+        success = g_discoveryResult.get();
+    }
+    if (g_assetPrefetch.valid()) {
+        g_assetPrefetch.get();
+    }
+    return success;
+}
+
+// Libera la sesión y todo lo que depende de ella (espacios, acciones, swapchains,
+// perfiles de foveation, passthrough). Instancia, EGL y recursos GL se conservan.
+static void destroySessionResources() {
+    // Terminar sesión si está corriendo
+    if (g_openxrState.sessionRunning && g_openxrState.session != XR_NULL_HANDLE) {
+        LOGI("Terminando sesión activa...");
+        XrResult result = xrEndSession(g_openxrState.session);
+        if (XR_FAILED(result)) {
+            LOGE("Error terminando sesión: %d", result);
         }
-        LOGI("✓ Extensiones verificadas correctamente");
+        g_openxrState.sessionRunning = false;
+    }
 
-        // 4. Configurar extensiones
-        std::vector<const char*> extensions = {
-                XR_KHR_ANDROID_CREATE_INSTANCE_EXTENSION_NAME,
-                XR_KHR_OPENGL_ES_ENABLE_EXTENSION_NAME
-        };
+    g_threadRegistry.unbindSession();
 
-        // 5. Crear instancia
-        XrInstanceCreateInfoAndroidKHR androidCreateInfo{XR_TYPE_INSTANCE_CREATE_INFO_ANDROID_KHR};
-        androidCreateInfo.applicationVM = g_openxrState.javaVm;
-        androidCreateInfo.applicationActivity = g_openxrState.activityObject;
-
-        XrInstanceCreateInfo instanceInfo{XR_TYPE_INSTANCE_CREATE_INFO};
-        strncpy(instanceInfo.applicationInfo.applicationName, "HolaMundo VR", XR_MAX_APPLICATION_NAME_SIZE - 1);
-        instanceInfo.applicationInfo.applicationName[XR_MAX_APPLICATION_NAME_SIZE - 1] = '\0';
-        strncpy(instanceInfo.applicationInfo.engineName, "Custom Engine", XR_MAX_ENGINE_NAME_SIZE - 1);
-        instanceInfo.applicationInfo.engineName[XR_MAX_ENGINE_NAME_SIZE - 1] = '\0';
-        instanceInfo.applicationInfo.applicationVersion = 1;
-        instanceInfo.applicationInfo.engineVersion = 1;
-        instanceInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
-        instanceInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
-        instanceInfo.enabledExtensionNames = extensions.data();
-        instanceInfo.next = &androidCreateInfo;
-
-        LOGI("Creando instancia OpenXR...");
-        if (!CheckXrResult(xrCreateInstance(&instanceInfo, &g_openxrState.instance), "xrCreateInstance")) {
-            return JNI_FALSE;
+    // Limpiar swapchains
+    cleanupSwapchains();
+    g_foveation.destroy();
+    g_passthrough.destroy();
+    g_swapchainHandles.clear();
+    g_handTracking.destroy();
+    g_poseService.destroy();
+    g_headPoseId = kInvalidPoseSpace;
+    g_input.detachSession();
+    if (g_openxrState.viewSpace != XR_NULL_HANDLE) {
+        xrDestroySpace(g_openxrState.viewSpace);
+        g_openxrState.viewSpace = XR_NULL_HANDLE;
+    }
+
+    // Limpiar espacio de referencia
+    if (g_openxrState.appSpace != XR_NULL_HANDLE) {
+        XrResult result = xrDestroySpace(g_openxrState.appSpace);
+        if (XR_FAILED(result)) {
+            LOGE("Error destruyendo space: %d", result);
         }
-        LOGI("✓ Instancia OpenXR creada correctamente");
-
-        // 6. Obtener propiedades del runtime
-        XrInstanceProperties instanceProperties{XR_TYPE_INSTANCE_PROPERTIES};
-        if (CheckXrResult(xrGetInstanceProperties(g_openxrState.instance, &instanceProperties), "xrGetInstanceProperties")) {
-            LOGI("Runtime: %s v%d.%d.%d",
-                 instanceProperties.runtimeName,
-                 XR_VERSION_MAJOR(instanceProperties.runtimeVersion),
-                 XR_VERSION_MINOR(instanceProperties.runtimeVersion),
-                 XR_VERSION_PATCH(instanceProperties.runtimeVersion));
+        g_openxrState.appSpace = XR_NULL_HANDLE;
+    }
+
+    // Limpiar sesión
+    if (g_openxrState.session != XR_NULL_HANDLE) {
+        XrResult result = xrDestroySession(g_openxrState.session);
+        if (XR_FAILED(result)) {
+            LOGE("Error destruyendo session: %d", result);
         }
+        g_openxrState.session = XR_NULL_HANDLE;
+    }
+    g_openxrState.isSessionCreated = false;
+    g_openxrState.sessionState = XR_SESSION_STATE_UNKNOWN;
+}
 
-        // 7. Obtener sistema HMD
-        XrSystemGetInfo systemInfo{XR_TYPE_SYSTEM_GET_INFO};
-        systemInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+// Cierre completo: sesión, recursos GL, instancia y contexto EGL
+static void shutdownOpenXR() {
+    LOGI("=== Cerrando OpenXR ===");
 
-        LOGI("Obteniendo sistema HMD...");
-        if (!CheckXrResult(xrGetSystem(g_openxrState.instance, &systemInfo, &g_openxrState.systemId), "xrGetSystem")) {
-            LOGE("No se pudo encontrar un HMD compatible");
-            return JNI_FALSE;
+    // No liberar nada mientras el arranque en segundo plano siga usando el estado
+    waitForBackgroundStartup();
+
+    try {
+        std::lock_guard<std::mutex> lock(g_openxrState.stateMutex);
+
+        // Detener el worker antes de liberar lo que sus trabajos referencian
+        g_uploadWorker.stop();
+        g_jobs.logStats();
+        g_jobs.stop();
+        g_frameGraph.clear();
+
+        // Los borrados GL necesitan el contexto dedicado: desde onDestroy no hay
+        // contexto activo y en el hilo GL el activo es el de GLSurfaceView
+        if (makeNativeContextCurrent()) {
+            ScopedHostContextRestore restoreHost;
+            destroySessionResources();
+            g_swapchainPool.logStats();
+            g_swapchainPool.destroy();
+            g_uniformRing.destroy();
+            g_frameArenas.logStats();
+            g_frameArenas.destroy();
+            g_lateLatch.destroy();
+            g_gpuTimer.destroy();
+            g_textureStreamer.cleanup();
+            releaseSceneResources();
+        } else {
+            if (g_openxrState.eglContext != EGL_NO_CONTEXT) {
+                LOGE("Contexto dedicado no disponible: sus objetos GL se liberan al destruirlo");
+            }
+            destroySessionResources();
         }
-        LOGI("✓ Sistema HMD encontrado (ID: %llu)", (unsigned long long)g_openxrState.systemId);
+        g_recovery.requested = kRecoveryNone;
+        g_recovery.level = kRecoveryNone;
+        g_latency.destroy();
+        g_poseLatency = PoseLatencyStats{};
+        g_input.destroy();
 
-        // 8. Verificar configuración de vista
-        uint32_t viewCount = 0;
-        XrViewConfigurationView viewConfigs[2] = {{XR_TYPE_VIEW_CONFIGURATION_VIEW}, {XR_TYPE_VIEW_CONFIGURATION_VIEW}};
+        // Limpiar instancia
+        if (g_openxrState.instance != XR_NULL_HANDLE) {
+            XrResult result = xrDestroyInstance(g_openxrState.instance);
+            if (XR_FAILED(result)) {
+                LOGE("Error destruyendo instance: %d", result);
+            }
+            g_openxrState.instance = XR_NULL_HANDLE;
+        }
+        g_xrDispatch.clear();
 
-        if (!CheckXrResult(xrEnumerateViewConfigurationViews(g_openxrState.instance, g_openxrState.systemId,
-                                                             XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO, 2, &viewCount, viewConfigs),
-                           "xrEnumerateViewConfigurationViews")) {
-            return JNI_FALSE;
+        // Limpiar recursos EGL (contexto dedicado y su pbuffer, si lo hay)
+        if (g_openxrState.eglContext != EGL_NO_CONTEXT) {
+            // Solo soltar el contexto si es el nuestro; el de GLSurfaceView puede estar activo aquí
+            if (eglGetCurrentContext() == g_openxrState.eglContext) {
+                eglMakeCurrent(g_openxrState.eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            }
+            eglDestroyContext(g_openxrState.eglDisplay, g_openxrState.eglContext);
+            g_openxrState.eglContext = EGL_NO_CONTEXT;
+        }
+        if (g_openxrState.eglSurface != EGL_NO_SURFACE) {
+            eglDestroySurface(g_openxrState.eglDisplay, g_openxrState.eglSurface);
+            g_openxrState.eglSurface = EGL_NO_SURFACE;
         }
+        if (g_openxrState.eglDisplay != EGL_NO_DISPLAY) {
+            eglTerminate(g_openxrState.eglDisplay);
+            g_openxrState.eglDisplay = EGL_NO_DISPLAY;
+        }
+        g_openxrState.eglConfig = nullptr;
 
-        if (viewCount != 2) {
-            LOGE("Se esperaban 2 vistas, pero se encontraron %d", viewCount);
-            return JNI_FALSE;
+        // Limpiar OpenXR loader
+        if (g_openxrState.loaderInitialized) {
+            LOGI("Limpiando recursos OpenXR...");
+            g_openxrState.loaderInitialized = false;
+            LOGI("✓ Recursos OpenXR limpiados");
         }
 
-        // Guardar configuraciones de vista
-        memcpy(g_viewConfigs, viewConfigs, sizeof(g_viewConfigs));
+        // Reset completo del estado
+        g_openxrState.reset();
+
+        LOGI("=== OpenXR cerrado correctamente ===");
+
+    } catch (const std::exception& e) {
+        LOGE("Excepción durante shutdown: %s", e.what());
+    } catch (...) {
+        LOGE("Excepción desconocida durante shutdown");
+    }
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_holamundo2_MainActivity_nativeInitialize(JNIEnv *env, jobject thiz) {
+    // Reanudación: instancia, sistema, contexto EGL y recursos GL siguen vivos
+    const bool discovered = waitForBackgroundStartup();
+    if (discovered && g_openxrState.instance != XR_NULL_HANDLE && g_openxrState.eglContext != EGL_NO_CONTEXT) {
+        LOGI("=== Reanudando OpenXR en caliente (instancia y recursos conservados) ===");
+        g_startupTimings = StartupTimings{};
+        g_startupTimings.begin = std::chrono::steady_clock::now();
+        g_startupTimings.warm = true;
+        return JNI_TRUE;
+    }
 
-        LOGI("✓ Configuración de vista estéreo verificada:");
-        for (int i = 0; i < 2; i++) {
-            LOGI("  Ojo %d: %dx%d (recomendado), %dx%d (máximo)",
-                 i,
-                 g_viewConfigs[i].recommendedImageRectWidth, g_viewConfigs[i].recommendedImageRectHeight,
-                 g_viewConfigs[i].maxImageRectWidth, g_viewConfigs[i].maxImageRectHeight);
+    LOGI("=== Inicializando OpenXR (arranque en paralelo) ===");
+
+    // Reset del estado (liberando lo que quedara de un arranque incompleto)
+    if (g_openxrState.instance != XR_NULL_HANDLE || g_openxrState.eglContext != EGL_NO_CONTEXT) {
+        shutdownOpenXR();
+    } else {
+        g_openxrState.reset();
+        cleanupSwapchains();
+    }
+    g_capabilities.reset();
+    g_startupTimings = StartupTimings{};
+    g_startupTimings.begin = std::chrono::steady_clock::now();
+
+    try {
+        // 1. Inicializar Loader OpenXR (necesita el JNIEnv de este hilo)
+        LOGI("=== VERIFICANDO DISPONIBILIDAD DE OPENXR ===");
+        if (!initializeOpenXRLoader(env, thiz)) {
+            LOGE("FALLO: OpenXR no está disponible");
+            return JNI_FALSE;
         }
+        g_startupTimings.loaderMs = elapsedMs(g_startupTimings.begin);
 
-        g_openxrState.isInitialized = true;
-        LOGI("=== OpenXR inicializado correctamente ===");
+        // 2-8. El resto corre en segundo plano; nativeCreateSession espera el resultado
+        startBackgroundStartup();
         return JNI_TRUE;
 
     } catch (const std::exception& e) {
@@ -460,72 +961,142 @@ Java_com_example_holamundo2_MainActivity_nativeInitialize(JNIEnv *env, jobject t
     }
 }
 
-// FUNCIÓN COMPLETAMENTE REESCRITA - Usando el contexto existente de GLSurfaceView
+// Crea un contexto GLES 3.2 propio, sin superficie de ventana y con prioridad alta si el driver lo permite.
+// El contexto de GLSurfaceView solo se usa para localizar el display y se restaura al final de cada frame.
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_example_holamundo2_MainActivity_nativeSetupEGL(JNIEnv *env, jobject thiz, jobject surface) {
-    LOGI("=== Configurando EGL para OpenXR (usando contexto existente) ===");
+    // El hilo GL de GLSurfaceView es el de render (cambia si se recrea la vista)
+    g_threadRegistry.registerCurrentThread(kThreadRoleRender, "xr_render");
+
+    if (g_openxrState.eglContext != EGL_NO_CONTEXT) {
+        // El contexto dedicado no se comparte con el de GLSurfaceView y sobrevive a la pausa
+        LOGI("Contexto EGL dedicado conservado, solo se actualiza el de GLSurfaceView");
+        g_openxrState.hostContext = eglGetCurrentContext();
+        g_openxrState.hostDrawSurface = eglGetCurrentSurface(EGL_DRAW);
+        g_openxrState.hostReadSurface = eglGetCurrentSurface(EGL_READ);
+        return JNI_TRUE;
+    }
 
-    // 1. Obtener el contexto EGL actual que ya está configurado por GLSurfaceView
-    EGLDisplay currentDisplay = eglGetCurrentDisplay();
-    EGLContext currentContext = eglGetCurrentContext();
-    EGLSurface currentSurface = eglGetCurrentSurface(EGL_DRAW);
+    LOGI("=== Configurando EGL para OpenXR (contexto dedicado) ===");
+    auto eglStart = std::chrono::steady_clock::now();
 
-    if (currentDisplay == EGL_NO_DISPLAY) {
-        LOGE("No hay display EGL actual - GLSurfaceView no está configurado");
-        return JNI_FALSE;
-    }
+    // 1. Recordar el contexto de GLSurfaceView para restaurarlo tras cada frame nativo
+    EGLDisplay display = eglGetCurrentDisplay();
+    g_openxrState.hostContext = eglGetCurrentContext();
+    g_openxrState.hostDrawSurface = eglGetCurrentSurface(EGL_DRAW);
+    g_openxrState.hostReadSurface = eglGetCurrentSurface(EGL_READ);
 
-    if (currentContext == EGL_NO_CONTEXT) {
-        LOGE("No hay contexto EGL actual - GLSurfaceView no está configurado");
+    if (display == EGL_NO_DISPLAY) {
+        LOGI("No hay display EGL actual, inicializando el display por defecto");
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    // Referencia propia al display (Android las cuenta): el eglTerminate que hace
+    // GLSurfaceView al pausar no debe invalidar el contexto dedicado
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        LOGE("No se pudo inicializar el display EGL: 0x%X", eglGetError());
         return JNI_FALSE;
     }
+    g_openxrState.eglDisplay = display;
 
-    LOGI("Usando contexto EGL existente de GLSurfaceView:");
-    LOGI("  Display: %p", currentDisplay);
-    LOGI("  Context: %p", currentContext);
-    LOGI("  Surface: %p", currentSurface);
+    LOGI("Contexto de GLSurfaceView (solo se restaura, no se usa para OpenXR):");
+    LOGI("  Display: %p", display);
+    LOGI("  Context: %p", g_openxrState.hostContext);
+    LOGI("  Surface: %p", g_openxrState.hostDrawSurface);
 
-    // 2. Obtener la configuración EGL del contexto actual
-    EGLint configId;
-    if (!eglQueryContext(currentDisplay, currentContext, EGL_CONFIG_ID, &configId)) {
-        LOGE("Failed to query EGL config ID. Error: 0x%X", eglGetError());
-        return JNI_FALSE;
-    }
+    // 2. Verificar extensiones EGL
+    const char* eglExtensions = eglQueryString(display, EGL_EXTENSIONS);
+    const bool surfaceless = eglExtensions && strstr(eglExtensions, "EGL_KHR_surfaceless_context");
+    const bool contextPriority = eglExtensions && strstr(eglExtensions, "EGL_IMG_context_priority");
+    LOGI("%s EGL_KHR_surfaceless_context %s", surfaceless ? "✓" : "✗", surfaceless ? "disponible" : "NO disponible");
+    LOGI("%s EGL_IMG_context_priority %s", contextPriority ? "✓" : "✗", contextPriority ? "disponible" : "NO disponible");
 
-    // Obtener la configuración usando el ID
+    // 3. Configuración mínima: color RGBA8, sin depth/stencil de ventana (OpenXR da sus propias imágenes)
     const EGLint configAttribs[] = {
-            EGL_CONFIG_ID, configId,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT_KHR,
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, 0,
+            EGL_STENCIL_SIZE, 0,
+            EGL_SAMPLES, 0,
             EGL_NONE
     };
 
-    EGLConfig config;
-    EGLint numConfigs;
-    if (!eglChooseConfig(currentDisplay, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
-        LOGE("Failed to get EGL config by ID. Error: 0x%X", eglGetError());
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        LOGE("No se encontró una configuración EGL mínima: 0x%X", eglGetError());
         return JNI_FALSE;
     }
 
-    // 3. Verificar configuración
     EGLint configRedSize, configGreenSize, configBlueSize, configAlphaSize, configDepthSize;
-    eglGetConfigAttrib(currentDisplay, config, EGL_RED_SIZE, &configRedSize);
-    eglGetConfigAttrib(currentDisplay, config, EGL_GREEN_SIZE, &configGreenSize);
-    eglGetConfigAttrib(currentDisplay, config, EGL_BLUE_SIZE, &configBlueSize);
-    eglGetConfigAttrib(currentDisplay, config, EGL_ALPHA_SIZE, &configAlphaSize);
-    eglGetConfigAttrib(currentDisplay, config, EGL_DEPTH_SIZE, &configDepthSize);
-
-    LOGI("Configuración EGL actual:");
-    LOGI("  R:%d G:%d B:%d A:%d Depth:%d",
+    eglGetConfigAttrib(display, config, EGL_RED_SIZE, &configRedSize);
+    eglGetConfigAttrib(display, config, EGL_GREEN_SIZE, &configGreenSize);
+    eglGetConfigAttrib(display, config, EGL_BLUE_SIZE, &configBlueSize);
+    eglGetConfigAttrib(display, config, EGL_ALPHA_SIZE, &configAlphaSize);
+    eglGetConfigAttrib(display, config, EGL_DEPTH_SIZE, &configDepthSize);
+    LOGI("Configuración EGL dedicada: R:%d G:%d B:%d A:%d Depth:%d",
          configRedSize, configGreenSize, configBlueSize, configAlphaSize, configDepthSize);
 
-    // 4. Verificar extensiones EGL
-    const char* eglExtensions = eglQueryString(currentDisplay, EGL_EXTENSIONS);
-    if (eglExtensions && strstr(eglExtensions, "EGL_KHR_surfaceless_context")) {
-        LOGI("✓ EGL_KHR_surfaceless_context disponible");
-    } else {
-        LOGI("✗ EGL_KHR_surfaceless_context NO disponible");
+    // 4. Crear contexto GLES 3.2 (con fallback a 3.1/3.0) y prioridad alta
+    EGLContext context = EGL_NO_CONTEXT;
+    for (EGLint minorVersion = 2; minorVersion >= 0 && context == EGL_NO_CONTEXT; minorVersion--) {
+        EGLint contextAttribs[7];
+        int attribIndex = 0;
+        contextAttribs[attribIndex++] = EGL_CONTEXT_MAJOR_VERSION_KHR;
+        contextAttribs[attribIndex++] = 3;
+        contextAttribs[attribIndex++] = EGL_CONTEXT_MINOR_VERSION_KHR;
+        contextAttribs[attribIndex++] = minorVersion;
+        if (contextPriority) {
+            contextAttribs[attribIndex++] = EGL_CONTEXT_PRIORITY_LEVEL_IMG;
+            contextAttribs[attribIndex++] = EGL_CONTEXT_PRIORITY_HIGH_IMG;
+        }
+        contextAttribs[attribIndex] = EGL_NONE;
+
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (context != EGL_NO_CONTEXT) {
+            LOGI("✓ Contexto OpenGL ES 3.%d creado", minorVersion);
+        }
+    }
+    if (context == EGL_NO_CONTEXT) {
+        LOGE("eglCreateContext falló: 0x%X", eglGetError());
+        return JNI_FALSE;
+    }
+
+    if (contextPriority) {
+        // El driver puede conceder una prioridad menor que la pedida
+        EGLint grantedPriority = 0;
+        eglQueryContext(display, context, EGL_CONTEXT_PRIORITY_LEVEL_IMG, &grantedPriority);
+        LOGI("Prioridad de contexto concedida: %s",
+             grantedPriority == EGL_CONTEXT_PRIORITY_HIGH_IMG ? "alta" :
+             grantedPriority == EGL_CONTEXT_PRIORITY_MEDIUM_IMG ? "media" : "baja");
+    }
+
+    // 5. Sin surfaceless_context hace falta un pbuffer 1x1 para poder hacer current el contexto
+    EGLSurface pbuffer = EGL_NO_SURFACE;
+    if (!surfaceless) {
+        const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        pbuffer = eglCreatePbufferSurface(display, config, pbufferAttribs);
+        if (pbuffer == EGL_NO_SURFACE) {
+            LOGE("eglCreatePbufferSurface falló: 0x%X", eglGetError());
+            eglDestroyContext(display, context);
+            return JNI_FALSE;
+        }
+    }
+
+    if (!eglMakeCurrent(display, pbuffer, pbuffer, context)) {
+        LOGE("eglMakeCurrent del contexto dedicado falló: 0x%X", eglGetError());
+        if (pbuffer != EGL_NO_SURFACE) {
+            eglDestroySurface(display, pbuffer);
+        }
+        eglDestroyContext(display, context);
+        return JNI_FALSE;
     }
+    ScopedHostContextRestore restoreHost;
 
-    // 5. Verificar OpenGL ES en el contexto actual
+    // 6. Verificar OpenGL ES en el contexto dedicado
     const char* glVersion = (const char*)glGetString(GL_VERSION);
     const char* glRenderer = (const char*)glGetString(GL_RENDERER);
     const char* glExtensions = (const char*)glGetString(GL_EXTENSIONS);
@@ -535,17 +1106,22 @@ Java_com_example_holamundo2_MainActivity_nativeSetupEGL(JNIEnv *env, jobject thi
 
     if (!glExtensions || strstr(glExtensions, "GL_OES_EGL_image") == nullptr) {
         LOGE("Required GL_OES_EGL_image extension not found");
+        restoreHostContext();
+        eglDestroyContext(display, context);
+        if (pbuffer != EGL_NO_SURFACE) {
+            eglDestroySurface(display, pbuffer);
+        }
         return JNI_FALSE;
     }
     LOGI("✓ GL_OES_EGL_image extension found");
 
-    // 6. Almacenar referencias del contexto existente
-    g_openxrState.eglDisplay = currentDisplay;
-    g_openxrState.eglContext = currentContext;
+    // 7. Almacenar el contexto dedicado: es el que se entrega a OpenXR
+    g_openxrState.eglDisplay = display;
+    g_openxrState.eglContext = context;
     g_openxrState.eglConfig = config;
-    // NO almacenamos eglSurface - OpenXR maneja sus propias superficies
+    g_openxrState.eglSurface = pbuffer;
 
-    // 7. Obtener ANativeWindow para referencia (pero no crear superficie)
+    // 8. Obtener ANativeWindow para referencia (pero no crear superficie)
     ANativeWindow* window = ANativeWindow_fromSurface(env, surface);
     if (window) {
         int32_t width = ANativeWindow_getWidth(window);
@@ -555,43 +1131,41 @@ Java_com_example_holamundo2_MainActivity_nativeSetupEGL(JNIEnv *env, jobject thi
         ANativeWindow_release(window); // Liberar inmediatamente
     }
 
-    LOGI("✓ Configuración EGL completada (usando contexto GLSurfaceView):");
+    LOGI("✓ Configuración EGL completada (contexto dedicado):");
     LOGI("  Display: %p", g_openxrState.eglDisplay);
     LOGI("  Config: %p", g_openxrState.eglConfig);
-    LOGI("  Context: %p (del GLSurfaceView)", g_openxrState.eglContext);
-    LOGI("  Surface: GLSurfaceView maneja la superficie principal");
+    LOGI("  Context: %p", g_openxrState.eglContext);
+    LOGI("  Surface: %s", pbuffer != EGL_NO_SURFACE ? "pbuffer 1x1" : "ninguna (surfaceless)");
+    g_startupTimings.eglMs = elapsedMs(eglStart);
+
+    // Shaders y geometría no dependen de la sesión: prepararlos mientras el
+    // descubrimiento de OpenXR sigue en su hilo. Si falla, se reintenta en el primer frame.
+    auto resourcesStart = std::chrono::steady_clock::now();
+    if (!initializeShaders()) {
+        LOGE("Recursos GL no listos al arrancar; se reintentará en el primer frame");
+    }
+    g_startupTimings.resourcesMs = elapsedMs(resourcesStart);
 
     return JNI_TRUE;
 }
 
-extern "C" JNIEXPORT jboolean JNICALL
-Java_com_example_holamundo2_MainActivity_nativeCreateSession(JNIEnv *env, jobject thiz) {
-    LOGI("=== Creando sesión OpenXR (estilo Meta) ===");
-
-    if (!g_openxrState.isInitialized) {
-        LOGE("OpenXR no está inicializado");
-        return JNI_FALSE;
-    }
-
+// Sesión, espacios, swapchains y recursos por sesión. Usa la instancia y el
+// contexto EGL existentes; shaders y assets ya cargados se reutilizan.
+static bool createSessionAndSwapchains() {
     try {
         // PASO CRÍTICO 1: Obtener requerimientos gráficos ANTES de crear sesión
         LOGI("Paso 1: Obteniendo requerimientos gráficos OpenXR...");
 
-        PFN_xrGetOpenGLESGraphicsRequirementsKHR pfnGetGraphicsRequirements = nullptr;
-        XrResult result = xrGetInstanceProcAddr(g_openxrState.instance,
-                                                "xrGetOpenGLESGraphicsRequirementsKHR",
-                                                (PFN_xrVoidFunction*)&pfnGetGraphicsRequirements);
-
-        if (XR_FAILED(result) || !pfnGetGraphicsRequirements) {
-            LOGE("No se pudo obtener xrGetOpenGLESGraphicsRequirementsKHR: %d", result);
-            return JNI_FALSE;
+        if (!g_xrDispatch.xrGetOpenGLESGraphicsRequirementsKHR) {
+            LOGE("No se pudo obtener xrGetOpenGLESGraphicsRequirementsKHR");
+            return false;
         }
 
         XrGraphicsRequirementsOpenGLESKHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_OPENGL_ES_KHR};
-        result = pfnGetGraphicsRequirements(g_openxrState.instance, g_openxrState.systemId, &graphicsRequirements);
+        XrResult result = g_xrDispatch.xrGetOpenGLESGraphicsRequirementsKHR(g_openxrState.instance, g_openxrState.systemId, &graphicsRequirements);
         if (XR_FAILED(result)) {
             LOGE("xrGetOpenGLESGraphicsRequirementsKHR falló: %d", result);
-            return JNI_FALSE;
+            return false;
         }
 
         LOGI("✓ Requerimientos gráficos obtenidos:");
@@ -600,33 +1174,20 @@ Java_com_example_holamundo2_MainActivity_nativeCreateSession(JNIEnv *env, jobjec
              XR_VERSION_MINOR(graphicsRequirements.minApiVersionSupported),
              XR_VERSION_PATCH(graphicsRequirements.minApiVersionSupported));
 
-        // PASO 2: Obtener contexto EGL actual del GLSurfaceView
-        LOGI("Paso 2: Obteniendo contexto EGL actual...");
-
-        EGLDisplay currentDisplay = eglGetCurrentDisplay();
-        EGLContext currentContext = eglGetCurrentContext();
+        // PASO 2: Activar el contexto EGL dedicado creado en nativeSetupEGL
+        LOGI("Paso 2: Activando contexto EGL dedicado...");
 
-        if (currentDisplay == EGL_NO_DISPLAY || currentContext == EGL_NO_CONTEXT) {
-            LOGE("No hay contexto EGL actual válido");
-            return JNI_FALSE;
+        if (!makeNativeContextCurrent()) {
+            LOGE("No hay contexto EGL dedicado válido");
+            return false;
         }
+        ScopedHostContextRestore restoreHost;
 
-        // Obtener configuración del contexto actual
-        EGLint configId;
-        if (!eglQueryContext(currentDisplay, currentContext, EGL_CONFIG_ID, &configId)) {
-            LOGE("No se pudo obtener config ID: 0x%X", eglGetError());
-            return JNI_FALSE;
-        }
-
-        const EGLint configAttribs[] = { EGL_CONFIG_ID, configId, EGL_NONE };
-        EGLConfig config;
-        EGLint numConfigs;
-        if (!eglChooseConfig(currentDisplay, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
-            LOGE("No se pudo obtener configuración EGL: 0x%X", eglGetError());
-            return JNI_FALSE;
-        }
+        EGLDisplay currentDisplay = g_openxrState.eglDisplay;
+        EGLContext currentContext = g_openxrState.eglContext;
+        EGLConfig config = g_openxrState.eglConfig;
 
-        LOGI("✓ Contexto EGL obtenido:");
+        LOGI("✓ Contexto EGL dedicado activo:");
         LOGI("  Display: %p", currentDisplay);
         LOGI("  Context: %p", currentContext);
         LOGI("  Config: %p", config);
@@ -664,7 +1225,7 @@ Java_com_example_holamundo2_MainActivity_nativeCreateSession(JNIEnv *env, jobjec
                     LOGE("  -> Error desconocido: %d", result);
                     break;
             }
-            return JNI_FALSE;
+            return false;
         }
 
         LOGI("✓ ¡Sesión OpenXR creada exitosamente!");
@@ -678,121 +1239,268 @@ Java_com_example_holamundo2_MainActivity_nativeCreateSession(JNIEnv *env, jobjec
 
         if (!CheckXrResult(xrCreateReferenceSpace(g_openxrState.session, &spaceInfo, &g_openxrState.appSpace),
                            "xrCreateReferenceSpace")) {
-            return JNI_FALSE;
-        }
-        // PASO 6: Crear swapchains para renderizado
-        LOGI("Paso 6: Creando swapchains para renderizado...");
-        // Verificar formatos de swapchain soportados
-        uint32_t formatCount = 0;
-        if (!CheckXrResult(xrEnumerateSwapchainFormats(g_openxrState.session, 0, &formatCount, nullptr),
-                           "xrEnumerateSwapchainFormats (count)")) {
-            return JNI_FALSE;
+            return false;
         }
 
-        std::vector<int64_t> formats(formatCount);
-        if (!CheckXrResult(xrEnumerateSwapchainFormats(g_openxrState.session, formatCount, &formatCount, formats.data()),
-                           "xrEnumerateSwapchainFormats (data)")) {
-            return JNI_FALSE;
+        // Acciones de los controladores; sin ellas la app sigue funcionando sin input.
+        // Se crean una vez por instancia y cada sesión solo las asocia.
+        if (!g_input.initializeInstance(g_openxrState.instance) || !g_input.attachSession(g_openxrState.session)) {
+            LOGE("Input de controladores no disponible");
         }
 
-        LOGI("Formatos de swapchain soportados (%d):", formatCount);
-        for (auto format : formats) {
-            LOGD("  - Format: 0x%08llX", (long long)format);
+        // Servicio de poses: todos los espacios registrados se localizan juntos una vez por
+        // frame. Solo se registran los que algo lee: la cabeza, para la profundidad de la
+        // cola de render. Los de los controladores se añadirán cuando haya quien los use.
+        g_poseService.initialize(g_xrDispatch);
+        spaceInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+        if (CheckXrResult(xrCreateReferenceSpace(g_openxrState.session, &spaceInfo, &g_openxrState.viewSpace),
+                          "xrCreateReferenceSpace (VIEW)")) {
+            g_headPoseId = g_poseService.registerSpace(g_openxrState.viewSpace, "head");
         }
 
-        // Buscar formato apropiado
-        int64_t selectedFormat = 0;
-        for (auto format : formats) {
-            if (format == GL_RGBA8) {
-                selectedFormat = format;
-                LOGI("✓ Usando formato GL_RGBA8");
-                break;
-            } else if (format == GL_RGB8 && selectedFormat == 0) {
-                selectedFormat = format;
-                LOGI("✓ Fallback a formato GL_RGB8");
-            }
-        }
-
-        if (selectedFormat == 0 && !formats.empty()) {
-            selectedFormat = formats[0];
-            LOGI("✓ Usando primer formato disponible: 0x%08llX", (long long)selectedFormat);
+        if (g_capabilities.has(kFeatureHandTracking) &&
+            !g_handTracking.initialize(g_xrDispatch, g_openxrState.instance, g_openxrState.systemId, g_openxrState.session)) {
+            LOGI("Hand tracking no disponible en esta sesión");
         }
+        // PASO 6: Crear swapchains para renderizado
+        LOGI("Paso 6: Creando swapchains para renderizado...");
+        // Formatos soportados (consultados una vez por instancia)
+        const std::vector<int64_t>& formats = g_swapchainPool.supportedFormats(g_openxrState.session);
 
-        if (selectedFormat == 0) {
+        // Política de formatos: sRGB para color y depth propio por swapchain
+        const SwapchainFormatChoice formatChoice = chooseSwapchainFormats(formats);
+        if (formatChoice.color == 0) {
             LOGE("No hay formatos de swapchain disponibles");
-            return JNI_FALSE;
+            return false;
         }
 
-        // Crear swapchains para cada ojo
-        g_swapchains.resize(2);
+        // Swapchain por ojo desde el pool (con un framebuffer ya configurado por imagen)
+        g_swapchains.assign(2, nullptr);
         for (int eye = 0; eye < 2; eye++) {
-            XrSwapchainCreateInfo swapchainInfo{XR_TYPE_SWAPCHAIN_CREATE_INFO};
-            swapchainInfo.width = g_viewConfigs[eye].recommendedImageRectWidth;
-            swapchainInfo.height = g_viewConfigs[eye].recommendedImageRectHeight;
-            swapchainInfo.format = selectedFormat;
-            swapchainInfo.mipCount = 1;
-            swapchainInfo.faceCount = 1;
-            swapchainInfo.arraySize = 1;
-            swapchainInfo.sampleCount = g_viewConfigs[eye].recommendedSwapchainSampleCount;
-            swapchainInfo.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT;
-
-            LOGI("Creando swapchain para ojo %d (%dx%d, samples: %d)...",
-                 eye, swapchainInfo.width, swapchainInfo.height, swapchainInfo.sampleCount);
-
-            if (!CheckXrResult(xrCreateSwapchain(g_openxrState.session, &swapchainInfo, &g_swapchains[eye].swapchain),
-                               "xrCreateSwapchain")) {
-                return JNI_FALSE;
+            SwapchainDesc desc;
+            desc.width = g_viewConfigs[eye].recommendedImageRectWidth;
+            desc.height = g_viewConfigs[eye].recommendedImageRectHeight;
+            desc.format = formatChoice.color;
+            desc.depthFormat = formatChoice.depth;
+            desc.arraySize = 1;
+            desc.sampleCount = g_viewConfigs[eye].recommendedSwapchainSampleCount;
+            desc.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT;
+
+            LOGI("Obteniendo swapchain para ojo %d (%dx%d, samples: %d)...",
+                 eye, desc.width, desc.height, desc.sampleCount);
+
+            g_swapchains[eye] = g_swapchainPool.acquire(g_openxrState.session, desc);
+            if (!g_swapchains[eye]) {
+                return false;
             }
 
-            g_swapchains[eye].width = swapchainInfo.width;
-            g_swapchains[eye].height = swapchainInfo.height;
+            LOGI("✓ Swapchain %d listo: %dx%d, %zu imágenes", eye,
+                 g_swapchains[eye]->width, g_swapchains[eye]->height, g_swapchains[eye]->images.size());
+        }
+        g_swapchainPool.logStats();
+        applyContentColorSpace(g_xrDispatch, g_openxrState.instance, g_openxrState.systemId, g_openxrState.session);
 
-            // Obtener imágenes del swapchain
-            uint32_t imageCount;
-            if (!CheckXrResult(xrEnumerateSwapchainImages(g_swapchains[eye].swapchain, 0, &imageCount, nullptr),
-                               "xrEnumerateSwapchainImages (count)")) {
-                return JNI_FALSE;
-            }
+        // PASO 7: Anillo UBO con un slot por imagen de swapchain en vuelo (mínimo triple buffer)
+        uint32_t uniformSlots = 3;
+        for (const auto& swapchain : g_swapchains) {
+            uniformSlots = std::max(uniformSlots, static_cast<uint32_t>(swapchain->images.size()));
+        }
+        if (!g_uniformRing.initialize(uniformSlots, kUniformSlotSize)) {
+            LOGE("No se pudo crear el anillo UBO");
+            return false;
+        }
+        // Un arena por slot del anillo: ambos se reciclan al mismo ritmo
+        if (!g_frameArenas.initialize(uniformSlots, kFrameArenaBytes, kWorkerArenaBytes)) {
+            return false;
+        }
 
-            g_swapchains[eye].images.resize(imageCount, {XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_ES_KHR});
-            if (!CheckXrResult(xrEnumerateSwapchainImages(g_swapchains[eye].swapchain, imageCount, &imageCount,
-                                                          reinterpret_cast<XrSwapchainImageBaseHeader*>(g_swapchains[eye].images.data())),
-                               "xrEnumerateSwapchainImages (data)")) {
-                return JNI_FALSE;
-            }
+        // PASO 8: Hilo de subida con contexto compartido; sin él, las subidas se hacen en el render
+        g_uploadWorker.threadRegistry = &g_threadRegistry;
+        if (g_uploadWorker.start(currentDisplay, config, currentContext)) {
+            g_textureStreamer.uploadWorker = &g_uploadWorker;
+        } else {
+            LOGE("Hilo de subida GL no disponible, subidas en el hilo de render");
+        }
+
+        LOGI("✓ Espacio de referencia creado");
 
-            LOGI("✓ Swapchain %d creado: %dx%d, %d imágenes", eye,
-                 g_swapchains[eye].width, g_swapchains[eye].height, imageCount);
+        // PASO 9: UBO de poses para late latching (opcional)
+        if (g_lateLatchRequested && !g_lateLatch.initialize(uniformSlots)) {
+            LOGI("Late latching desactivado");
         }
 
+        // PASO 10: Foveation (el modo pedido se aplica en el primer frame) y tiempos de GPU
+        g_swapchainHandles.clear();
+        for (const auto& swapchain : g_swapchains) {
+            g_swapchainHandles.push_back(swapchain->swapchain);
+        }
+        if (g_capabilities.has(kFeatureFoveation) &&
+            !g_foveation.initialize(g_xrDispatch, g_openxrState.instance, g_openxrState.systemId,
+                                    g_openxrState.session)) {
+            LOGE("Foveation no disponible");
+        }
+        g_gpuTimer.initialize(kGpuTimerQueries);
 
-        LOGI("✓ Espacio de referencia creado");
+        // PASO 11: Passthrough (pausado hasta que se pida el modo de realidad mixta)
+        if (g_capabilities.has(kFeaturePassthrough) &&
+            !g_passthrough.initialize(g_xrDispatch, g_openxrState.instance, g_openxrState.systemId, g_openxrState.session)) {
+            LOGE("Passthrough no disponible");
+        }
 
-        // Almacenar configuración
-        g_openxrState.eglDisplay = currentDisplay;
-        g_openxrState.eglContext = currentContext;
-        g_openxrState.eglConfig = config;
-        g_openxrState.isSessionCreated = true;
+        // PASO 12: Job system del frame y comunicar al runtime los hilos registrados
+        g_jobs.start(kAutoWorkerCount, &g_threadRegistry);
+        if (g_frameGraph.empty()) {
+            // Poses y manos son independientes entre sí y solo dependen de xrSyncActions
+            g_frameGraph.add("poses", [] {
+                g_poseService.update(g_openxrState.session, g_openxrState.appSpace, g_frameGraphTime);
+            });
+            g_frameGraph.add("manos", [] { g_handTracking.update(g_openxrState.appSpace, g_frameGraphTime); });
+        }
+        g_threadRegistry.bindSession(g_xrDispatch, g_openxrState.session);
 
-        LOGI("=== Sesión OpenXR creada correctamente ===");
-        return JNI_TRUE;
+        g_openxrState.isSessionCreated = true;
+        return true;
 
     } catch (const std::exception& e) {
         LOGE("Excepción en createSession: %s", e.what());
-        return JNI_FALSE;
+        return false;
     } catch (...) {
         LOGE("Excepción desconocida en createSession");
+        return false;
+    }
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_holamundo2_MainActivity_nativeCreateSession(JNIEnv *env, jobject thiz) {
+    LOGI("=== Creando sesión OpenXR (estilo Meta) ===");
+
+    // Esperar al descubrimiento lanzado en nativeInitialize (normalmente ya terminó)
+    auto waitStart = std::chrono::steady_clock::now();
+    const bool discovered = waitForBackgroundStartup();
+    g_startupTimings.discoveryWaitMs = elapsedMs(waitStart);
+    if (!discovered || !g_openxrState.isInitialized) {
+        LOGE("OpenXR no está inicializado");
         return JNI_FALSE;
     }
+    if (g_openxrState.isSessionCreated) {
+        // Reanudación en caliente: la sesión y los swapchains siguen siendo válidos
+        LOGI("✓ Sesión OpenXR conservada");
+        return JNI_TRUE;
+    }
+    auto sessionStart = std::chrono::steady_clock::now();
+
+    if (!createSessionAndSwapchains()) {
+        return JNI_FALSE;
+    }
+    // Una sesión nueva sustituye a cualquier recuperación pendiente
+    g_recovery.requested = kRecoveryNone;
+    g_recovery.level = kRecoveryNone;
+
+    g_startupTimings.sessionMs = elapsedMs(sessionStart);
+    if (g_startupTimings.warm) {
+        LOGI("Reanudación en caliente: sesión y swapchains recreados en %.1f ms", g_startupTimings.sessionMs);
+    } else {
+        LOGI("Arranque: loader %.1f ms | en paralelo: descubrimiento %.1f ms, precarga %.1f ms, "
+             "EGL %.1f ms, recursos GL %.1f ms | espera %.1f ms | sesión %.1f ms | total %.1f ms",
+             g_startupTimings.loaderMs, g_startupTimings.discoveryMs, g_startupTimings.prefetchMs,
+             g_startupTimings.eglMs, g_startupTimings.resourcesMs, g_startupTimings.discoveryWaitMs,
+             g_startupTimings.sessionMs, elapsedMs(g_startupTimings.begin));
+    }
+
+    LOGI("=== Sesión OpenXR creada correctamente ===");
+    return JNI_TRUE;
+}
+
+static void scheduleRecoveryRetry(const char* step) {
+    const auto now = std::chrono::steady_clock::now();
+    g_recovery.backoff = std::min(g_recovery.backoff * 2, kRecoveryMaxBackoff);
+    g_recovery.nextAttempt = now + g_recovery.backoff;
+    LOGE("Recuperación: fallo al recrear %s (intento %u), reintento en %lld ms",
+         step, g_recovery.attempts, (long long)g_recovery.backoff.count());
+}
+
+// Un paso de recuperación por frame, sin bloquear el hilo GL: la instancia se
+// recrea en segundo plano y la sesión en cuanto la instancia está lista.
+static void runRecovery() {
+    const auto now = std::chrono::steady_clock::now();
+    const int requested = g_recovery.requested.exchange(kRecoveryNone);
+    if (requested > g_recovery.level) {
+        if (g_recovery.level == kRecoveryNone) {
+            LOGE("=== Recuperación OpenXR: %s perdida ===", requested == kRecoveryInstance ? "instancia" : "sesión");
+            g_recovery.lostAt = now;
+            g_recovery.nextAttempt = now;
+            g_recovery.attempts = 0;
+            g_recovery.backoff = kRecoveryInitialBackoff / 2;
+        }
+        g_recovery.level = requested;
+    }
+    if (g_recovery.level == kRecoveryNone || now < g_recovery.nextAttempt) {
+        return;
+    }
+
+    // Descubrimiento lanzado en un intento anterior
+    if (g_discoveryResult.valid()) {
+        if (g_discoveryResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+        if (!g_discoveryResult.get()) {
+            scheduleRecoveryRetry("la instancia");
+            return;
+        }
+        g_recovery.level = kRecoverySession;
+    }
+
+    // Lo que depende de la sesión se descarta siempre; programas GL y assets se conservan
+    destroySessionResources();
+
+    g_recovery.attempts++;
+    if (g_recovery.level == kRecoveryInstance) {
+        g_swapchainPool.destroy();
+        g_latency.destroy();
+        g_input.destroy();
+        if (g_openxrState.instance != XR_NULL_HANDLE) {
+            xrDestroyInstance(g_openxrState.instance);
+            g_openxrState.instance = XR_NULL_HANDLE;
+        }
+        g_xrDispatch.clear();
+        g_openxrState.isInitialized = false;
+        launchDiscovery();
+        return;
+    }
+
+    if (!createSessionAndSwapchains()) {
+        destroySessionResources();
+        scheduleRecoveryRetry("la sesión");
+        return;
+    }
+    LOGI("✓ Recuperación OpenXR completada en %.1f ms (%u intentos)", elapsedMs(g_recovery.lostAt), g_recovery.attempts);
+    g_recovery.level = kRecoveryNone;
 }
 
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thiz) {
+    // Sesión o instancia perdidas: no se renderiza hasta terminar la recuperación
+    if (g_recovery.level != kRecoveryNone || g_recovery.requested.load() != kRecoveryNone) {
+        if (!makeNativeContextCurrent()) {
+            return JNI_FALSE;
+        }
+        ScopedHostContextRestore restoreHost;
+        runRecovery();
+        return JNI_TRUE;
+    }
+
     if (!g_openxrState.isSessionCreated || g_swapchains.empty()) {
         LOGD("RunFrame: No hay sesión creada o swapchains vacíos");
         return JNI_FALSE;
     }
 
+    // Todo el trabajo GL del frame va al contexto dedicado; GLSurfaceView recupera el suyo al salir
+    if (!makeNativeContextCurrent()) {
+        LOGE("RunFrame: no se pudo activar el contexto EGL dedicado");
+        return JNI_FALSE;
+    }
+    ScopedHostContextRestore restoreHost;
+
     try {
         // Poll events (simplificado para logs)
         XrEventDataBuffer eventData{XR_TYPE_EVENT_DATA_BUFFER};
@@ -827,17 +1535,21 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
                             break;
                         }
                         case XR_SESSION_STATE_EXITING:
-                        case XR_SESSION_STATE_LOSS_PENDING:
-                            LOGI("Sesión saliendo o perdida");
+                            LOGI("Sesión saliendo");
                             return JNI_FALSE;
+                        case XR_SESSION_STATE_LOSS_PENDING:
+                            LOGE("Sesión perdida, se recreará");
+                            requestRecovery(kRecoverySession);
+                            return JNI_TRUE;
                         default:
                             break;
                     }
                     break;
                 }
                 case XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING:
-                    LOGE("Instancia OpenXR perdida");
-                    return JNI_FALSE;
+                    LOGE("Instancia OpenXR perdida, se recreará");
+                    requestRecovery(kRecoveryInstance);
+                    return JNI_TRUE;
                 case 40: // XR_TYPE_EVENT_DATA_DISPLAY_REFRESH_RATE_CHANGED_FB
                     break;
                 default:
@@ -846,6 +1558,9 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
             }
             result = xrPollEvent(g_openxrState.instance, &eventData);
         }
+        if (result != XR_EVENT_UNAVAILABLE && !CheckXrResult(result, "xrPollEvent")) {
+            return JNI_TRUE;
+        }
 
         // Verificar estado de sesión
         if (g_openxrState.sessionState != XR_SESSION_STATE_SYNCHRONIZED &&
@@ -857,6 +1572,14 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
 
         LOGD("=== INICIO FRAME ===");
 
+        // Fallo inyectado (pruebas): se trata igual que si lo devolviera xrWaitFrame
+        const int injectedFault = g_injectedFault.exchange(kRecoveryNone);
+        if (injectedFault != kRecoveryNone) {
+            CheckXrResult(injectedFault == kRecoveryInstance ? XR_ERROR_INSTANCE_LOST : XR_ERROR_SESSION_LOST,
+                          "xrWaitFrame (fallo inyectado)");
+            return JNI_TRUE;
+        }
+
         // Wait frame
         XrFrameWaitInfo frameWaitInfo{XR_TYPE_FRAME_WAIT_INFO};
         XrFrameState frameState{XR_TYPE_FRAME_STATE};
@@ -865,6 +1588,20 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
         }
         LOGD("WaitFrame completado, shouldRender: %s", frameState.shouldRender ? "true" : "false");
 
+        // Arena del frame (el de hace N frames, cuyo fence ya está señalizado)
+        g_frameArenas.beginFrame();
+        LinearArena& frameArena = g_frameArenas.current();
+
+        // Un único xrSyncActions por frame; el resto del frame lee g_input.snapshot
+        g_latency.beginFrame();
+        g_input.sync(g_openxrState.session, frameState.predictedDisplayTime);
+        g_latency.mark(kLatencyInputToPhoton);
+
+        // Poses registradas en una sola llamada (el render lee la cabeza de g_poseService.snapshot())
+        // y las articulaciones de las manos, en paralelo en el job system
+        g_frameGraphTime = frameState.predictedDisplayTime;
+        g_frameGraph.execute(g_jobs);
+
         // Begin frame
         XrFrameBeginInfo frameBeginInfo{XR_TYPE_FRAME_BEGIN_INFO};
         if (!CheckXrResult(xrBeginFrame(g_openxrState.session, &frameBeginInfo), "xrBeginFrame")) {
@@ -872,10 +1609,50 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
         }
         LOGD("BeginFrame completado");
 
+        // Tras xrBeginFrame toda salida pasa por xrEndFrame: un frame sin cerrar hace que el
+        // runtime rechace los siguientes con XR_ERROR_CALL_ORDER_INVALID. Esta ruta libera las
+        // imágenes adquiridas, cierra los frames de late latch, anillo, arena y latencia y
+        // envía el frame sin layers.
+        bool imageAcquired[2] = {false, false};
+        bool lateLatchOpen = false;
+        auto endFrameWithoutLayers = [&](const char* reason) -> bool {
+            g_gpuTimer.end();
+            if (lateLatchOpen) {
+                g_lateLatch.endFrame();
+                lateLatchOpen = false;
+            }
+            if (imageAcquired[0] || imageAcquired[1]) {
+                g_glState.bindVertexArray(0);
+                g_glState.bindFramebuffer(0);
+            }
+            for (int eye = 0; eye < 2; eye++) {
+                if (imageAcquired[eye]) {
+                    imageAcquired[eye] = false;
+                    XrSwapchainImageReleaseInfo releaseInfo{XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
+                    CheckXrResult(xrReleaseSwapchainImage(g_swapchains[eye]->swapchain, &releaseInfo),
+                                  "xrReleaseSwapchainImage (frame sin layers)");
+                }
+            }
+            g_uniformRing.endFrame();
+
+            XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
+            frameEndInfo.displayTime = frameState.predictedDisplayTime;
+            frameEndInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+            frameEndInfo.layerCount = 0;
+            frameEndInfo.layers = nullptr;
+            const bool ended = CheckXrResult(xrEndFrame(g_openxrState.session, &frameEndInfo), reason);
+            g_latency.endFrame(frameState.predictedDisplayTime);
+            g_frameArenas.endFrame();
+            return ended;
+        };
+
         // Preparar layers
-        std::vector<XrCompositionLayerBaseHeader*> layers;
+        ArenaVector<XrCompositionLayerBaseHeader*> layers(frameArena);
+        layers.reserve(2);
         XrCompositionLayerProjection layer{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
-        std::vector<XrCompositionLayerProjectionView> projectionViews(2);
+        XrCompositionLayerPassthroughFB passthroughLayer{XR_TYPE_COMPOSITION_LAYER_PASSTHROUGH_FB};
+        XrCompositionLayerAlphaBlendFB alphaBlend{XR_TYPE_COMPOSITION_LAYER_ALPHA_BLEND_FB};
+        ArenaVector<XrCompositionLayerProjectionView> projectionViews(2, frameArena);
 
         if (frameState.shouldRender) {
             LOGD("Iniciando renderizado...");
@@ -883,16 +1660,25 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
             // Inicializar shaders si es necesario
             if (!initializeShaders()) {
                 LOGE("Error inicializando shaders");
-                // End frame sin layers
-                XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
-                frameEndInfo.displayTime = frameState.predictedDisplayTime;
-                frameEndInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
-                frameEndInfo.layerCount = 0;
-                frameEndInfo.layers = nullptr;
-                xrEndFrame(g_openxrState.session, &frameEndInfo);
+                endFrameWithoutLayers("xrEndFrame (sin shaders)");
                 return JNI_FALSE;
             }
 
+            // Publicar las subidas terminadas en el worker y encolar los mips pendientes
+            g_uploadWorker.pollCompleted();
+            g_textureStreamer.touch(g_sceneTexture);
+            g_textureStreamer.update();
+
+            // Con passthrough el fondo queda transparente y no se sombrea
+            g_passthrough.setRunning(g_passthroughRequested);
+            const bool passthroughActive = g_passthrough.isRunning();
+
+            // Cambios de modo de foveation y centro eye-tracked del frame
+            g_foveation.update(g_swapchainHandles);
+            g_gpuTimer.collect([](uint32_t mode, uint64_t elapsedNs) {
+                g_foveation.recordGpuTime(static_cast<FoveationMode>(mode), elapsedNs / 1.0e6);
+            });
+
             // Obtener poses de las vistas
             XrViewState viewState{XR_TYPE_VIEW_STATE};
             uint32_t viewCount = 2;
@@ -903,10 +1689,13 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
             locateInfo.displayTime = frameState.predictedDisplayTime;
             locateInfo.space = g_openxrState.appSpace;
 
+            auto earlyLocateTime = std::chrono::steady_clock::now();
             if (!CheckXrResult(xrLocateViews(g_openxrState.session, &locateInfo, &viewState, viewCount, &viewCount, views),
                                "xrLocateViews")) {
+                endFrameWithoutLayers("xrEndFrame (sin vistas)");
                 return JNI_FALSE;
             }
+            g_latency.mark(kLatencyPoseToPhoton);
 
             LOGD("Views localizadas. ViewState flags: 0x%X", viewState.viewStateFlags);
 
@@ -914,79 +1703,155 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
             if (!(viewState.viewStateFlags & XR_VIEW_STATE_POSITION_VALID_BIT) ||
                 !(viewState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT)) {
                 LOGD("Vistas no válidas, saltando renderizado");
+                return endFrameWithoutLayers("xrEndFrame (no render)") ? JNI_TRUE : JNI_FALSE;
+            }
+
+            // Escribir los datos uniformes del frame con memcpy directo sobre el anillo
+            if (!g_uniformRing.beginFrame()) {
+                LOGE("No se pudo preparar el slot del anillo UBO");
+                endFrameWithoutLayers("xrEndFrame (sin anillo UBO)");
+                return JNI_FALSE;
+            }
+
+            // Con late latching las vistas van a su propio UBO, que se parchea antes de enviar
+            const bool lateLatch = g_lateLatchRequested && g_lateLatch.isAvailable() && g_lateLatch.beginFrame();
+            lateLatchOpen = lateLatch;
+            UniformAllocation viewUniforms[2];
+            for (int eye = 0; eye < 2; eye++) {
+                ViewUniforms viewData;
+                viewData.viewProj = mat4ViewProjection(views[eye], kNearZ, kFarZ);
+                if (lateLatch) {
+                    g_lateLatch.write(eye, viewData);
+                    continue;
+                }
+                viewUniforms[eye] = g_uniformRing.allocate(sizeof(ViewUniforms));
+                if (!viewUniforms[eye].data) {
+                    LOGE("Sin espacio en el anillo UBO para la vista %d", eye);
+                    endFrameWithoutLayers("xrEndFrame (sin espacio en el anillo UBO)");
+                    return JNI_FALSE;
+                }
+                memcpy(viewUniforms[eye].data, &viewData, sizeof(ViewUniforms));
+            }
 
-                XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
-                frameEndInfo.displayTime = frameState.predictedDisplayTime;
-                frameEndInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
-                frameEndInfo.layerCount = 0;
-                frameEndInfo.layers = nullptr;
-                return CheckXrResult(xrEndFrame(g_openxrState.session, &frameEndInfo), "xrEndFrame (no render)") ? JNI_TRUE : JNI_FALSE;
+            // Rectángulo fijo a 1.5 m delante del origen del espacio local
+            DrawUniforms drawData;
+            drawData.model = mat4Translation(0.0f, 0.0f, -1.5f);
+            // Con textura el color solo la modula; sin ella el rectángulo sigue siendo verde
+            const bool textured = g_sceneTexture != kInvalidTexture;
+            drawData.color[0] = textured ? 1.0f : 0.0f;
+            drawData.color[1] = 1.0f;
+            drawData.color[2] = textured ? 1.0f : 0.0f;
+            drawData.color[3] = 1.0f;
+            // Profundidad para la cola de render: distancia de la cabeza (snapshot de poses del
+            // frame) al objeto; sin pose válida, el centro entre ambos ojos
+            const PoseSnapshot& poses = g_poseService.snapshot();
+            XrVector3f head;
+            if (poses.isValid(g_headPoseId)) {
+                head = poses.pose(g_headPoseId).position;
+            } else {
+                head.x = 0.5f * (views[0].pose.position.x + views[1].pose.position.x);
+                head.y = 0.5f * (views[0].pose.position.y + views[1].pose.position.y);
+                head.z = 0.5f * (views[0].pose.position.z + views[1].pose.position.z);
             }
+            const float dx = drawData.model.m[12] - head.x;
+            const float dy = drawData.model.m[13] - head.y;
+            const float dz = drawData.model.m[14] - head.z;
+            const float drawDepth = std::sqrt(dx * dx + dy * dy + dz * dz);
+            const RenderLayer drawLayer = drawData.color[3] < 1.0f ? kRenderLayerTransparent : kRenderLayerOpaque;
+            // Un paquete por malla con su propio bloque DrawData; se ordenan una vez y se reproducen por ojo
+            g_drawPackets.record(g_jobs, frameArena, &g_uniformRing, static_cast<uint32_t>(g_sceneMeshes.size()), 1,
+                                 sizeof(DrawUniforms), [&](DrawStream& stream, uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; i++) {
+                    const GpuMesh& mesh = g_sceneMeshes[i];
+                    UniformAllocation uniforms = stream.allocateUniforms(sizeof(DrawUniforms));
+                    if (!uniforms.data) {
+                        // Sin bloque DrawData no hay draw: lo cuenta el LOGE de paquetes descartados
+                        stream.dropped += end - i;
+                        return;
+                    }
+                    memcpy(uniforms.data, &drawData, sizeof(DrawUniforms));
+
+                    DrawPacket packet;
+                    packet.program = g_shaderProgram;
+                    packet.vao = mesh.vao;
+                    packet.uniformOffset = static_cast<uint32_t>(uniforms.offset);
+                    packet.uniformSize = sizeof(DrawUniforms);
+                    packet.count = static_cast<uint32_t>(mesh.indexCount > 0 ? mesh.indexCount : mesh.vertexCount);
+                    packet.indexType = static_cast<uint16_t>(mesh.indexCount > 0 ? mesh.indexType : GL_NONE);
+                    packet.sortKey = makeRenderKey(drawLayer, packet.program, packet.vao, drawDepth);
+                    stream.push(packet);
+                }
+            });
 
-            // Renderizar cada ojo
+            g_uniformRing.flush();
+
+            // Grabar ambos ojos; las imágenes se liberan después porque liberar implica un flush
+            const bool gpuTimed = g_gpuTimer.begin(g_foveation.activeMode);
+            // El código anterior llama a GL directamente: el estado parte de desconocido
+            g_glState.beginFrame();
             for (int eye = 0; eye < 2; eye++) {
                 LOGD("Renderizando ojo %d", eye);
 
                 // Adquirir imagen del swapchain
                 uint32_t imageIndex;
                 XrSwapchainImageAcquireInfo acquireInfo{XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO};
-                if (!CheckXrResult(xrAcquireSwapchainImage(g_swapchains[eye].swapchain, &acquireInfo, &imageIndex),
+                if (!CheckXrResult(xrAcquireSwapchainImage(g_swapchains[eye]->swapchain, &acquireInfo, &imageIndex),
                                    "xrAcquireSwapchainImage")) {
                     LOGE("Error adquiriendo imagen swapchain ojo %d", eye);
+                    endFrameWithoutLayers("xrEndFrame (error de swapchain)");
                     return JNI_FALSE;
                 }
+                imageAcquired[eye] = true;
                 LOGD("Imagen swapchain adquirida: %d", imageIndex);
 
                 // Esperar imagen
                 XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
                 waitInfo.timeout = XR_INFINITE_DURATION;
-                if (!CheckXrResult(xrWaitSwapchainImage(g_swapchains[eye].swapchain, &waitInfo),
+                if (!CheckXrResult(xrWaitSwapchainImage(g_swapchains[eye]->swapchain, &waitInfo),
                                    "xrWaitSwapchainImage")) {
                     LOGE("Error esperando imagen swapchain ojo %d", eye);
+                    endFrameWithoutLayers("xrEndFrame (error de swapchain)");
                     return JNI_FALSE;
                 }
 
-                // Configurar framebuffer
-                GLuint framebuffer;
-                glGenFramebuffers(1, &framebuffer);
-                glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-
-                GLuint texture = g_swapchains[eye].images[imageIndex].image;
-                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
-
-                GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-                if (status != GL_FRAMEBUFFER_COMPLETE) {
-                    LOGE("Framebuffer incompleto para ojo %d: 0x%x", eye, status);
-                    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-                    glDeleteFramebuffers(1, &framebuffer);
-                    return JNI_FALSE;
-                }
-                LOGD("Framebuffer configurado correctamente para ojo %d", eye);
+                // Framebuffer de la imagen (configurado y validado al crear el swapchain)
+                g_glState.bindFramebuffer(g_swapchains[eye]->framebuffers[imageIndex]);
 
                 // Configurar viewport
-                glViewport(0, 0, g_swapchains[eye].width, g_swapchains[eye].height);
-                LOGD("Viewport configurado: %dx%d", g_swapchains[eye].width, g_swapchains[eye].height);
+                g_glState.viewport(0, 0, g_swapchains[eye]->width, g_swapchains[eye]->height);
+                LOGD("Viewport configurado: %dx%d", g_swapchains[eye]->width, g_swapchains[eye]->height);
 
                 // ===== RENDERIZADO MUY SIMPLE =====
 
-                // Limpiar con color distintivo para cada ojo
-                if (eye == 0) {
-                    glClearColor(0.1f, 0.0f, 0.0f, 1.0f); // Rojo oscuro para ojo izquierdo
+                // Limpiar con color distintivo para cada ojo (transparente con passthrough)
+                if (passthroughActive) {
+                    g_glState.clearColor(0.0f, 0.0f, 0.0f, 0.0f);
+                } else if (eye == 0) {
+                    g_glState.clearColor(0.1f, 0.0f, 0.0f, 1.0f); // Rojo oscuro para ojo izquierdo
                 } else {
-                    glClearColor(0.0f, 0.0f, 0.1f, 1.0f); // Azul oscuro para ojo derecho
+                    g_glState.clearColor(0.0f, 0.0f, 0.1f, 1.0f); // Azul oscuro para ojo derecho
                 }
                 glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                g_glState.setEnabled(GL_DEPTH_TEST, g_swapchains[eye]->depthBuffer != 0);
                 LOGD("Clear completado para ojo %d", eye);
 
-                // Usar shader program
-                glUseProgram(g_shaderProgram);
-                glBindVertexArray(g_VAO);
-
-                // Renderizar rectángulo
-                glDrawArrays(GL_TRIANGLES, 0, 6);
+                // Datos de la vista y escena reproducida desde los paquetes ordenados
+                if (lateLatch) {
+                    g_lateLatch.bind(g_glState, kViewUniformBinding, eye);
+                } else {
+                    g_uniformRing.bind(g_glState, kViewUniformBinding, viewUniforms[eye]);
+                }
+                if (g_sceneTexture != kInvalidTexture) {
+                    g_textureStreamer.bind(g_glState, g_sceneTexture, kSceneTextureUnit);
+                } else {
+                    g_glState.bindTexture(kSceneTextureUnit, GL_TEXTURE_2D, g_whiteTexture);
+                }
+                g_drawPackets.replay(g_glState, g_uniformRing.buffer, kDrawUniformBinding);
 
-                glBindVertexArray(0);
-                glUseProgram(0);
+                // El depth no sale del tile: descartarlo evita escribirlo a memoria
+                if (g_swapchains[eye]->depthBuffer != 0) {
+                    glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &g_swapchains[eye]->depthAttachment);
+                }
 
                 // Verificar errores OpenGL
                 GLenum glError = glGetError();
@@ -995,16 +1860,57 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
                 } else {
                     LOGD("Renderizado completado sin errores para ojo %d", eye);
                 }
+            }
+            // Desenlazar una vez por frame en lugar de por ojo
+            g_glState.bindVertexArray(0);
+            g_glState.bindFramebuffer(0);
+
+            if (gpuTimed) {
+                g_gpuTimer.end();
+                if (++g_gpuTimedFrames % kPoseLatencyLogInterval == 0) {
+                    LOGI("GPU por modo de foveation: desactivada %.2f ms, fija %.2f ms, eye-tracked %.2f ms",
+                         g_foveation.gpuStats[kFoveationOff].averageMs,
+                         g_foveation.gpuStats[kFoveationFixed].averageMs,
+                         g_foveation.gpuStats[kFoveationEyeTracked].averageMs);
+                }
+            }
 
-                // Limpiar framebuffer
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-                glDeleteFramebuffers(1, &framebuffer);
+            // Late latching: relocalizar las vistas con el mismo tiempo de display y
+            // parchear el UBO antes de que el trabajo llegue a la GPU
+            auto lateLocateTime = earlyLocateTime;
+            if (lateLatch) {
+                XrViewState lateViewState{XR_TYPE_VIEW_STATE};
+                XrView lateViews[2] = {{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+                uint32_t lateViewCount = 2;
+                lateLocateTime = std::chrono::steady_clock::now();
+                XrResult lateResult = xrLocateViews(g_openxrState.session, &locateInfo, &lateViewState,
+                                                    lateViewCount, &lateViewCount, lateViews);
+                const XrViewStateFlags kPoseValid = XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_VALID_BIT;
+                if (XR_SUCCEEDED(lateResult) && (lateViewState.viewStateFlags & kPoseValid) == kPoseValid) {
+                    for (int eye = 0; eye < 2; eye++) {
+                        ViewUniforms viewData;
+                        viewData.viewProj = mat4ViewProjection(lateViews[eye], kNearZ, kFarZ);
+                        g_lateLatch.write(eye, viewData);
+                        // El compositor debe recibir exactamente la pose con la que se renderizó
+                        views[eye] = lateViews[eye];
+                    }
+                    g_poseLatency.latchedFrames++;
+                    g_latency.mark(kLatencyPoseToPhoton);
+                } else {
+                    lateLocateTime = earlyLocateTime;
+                }
+                g_lateLatch.endFrame();
+                lateLatchOpen = false;
+            }
 
-                // Liberar imagen del swapchain
+            for (int eye = 0; eye < 2; eye++) {
+                // Liberar imagen del swapchain (si falla, la ruta de error libera el otro ojo)
+                imageAcquired[eye] = false;
                 XrSwapchainImageReleaseInfo releaseInfo{XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
-                if (!CheckXrResult(xrReleaseSwapchainImage(g_swapchains[eye].swapchain, &releaseInfo),
+                if (!CheckXrResult(xrReleaseSwapchainImage(g_swapchains[eye]->swapchain, &releaseInfo),
                                    "xrReleaseSwapchainImage")) {
                     LOGE("Error liberando imagen swapchain ojo %d", eye);
+                    endFrameWithoutLayers("xrEndFrame (error de swapchain)");
                     return JNI_FALSE;
                 }
                 LOGD("Imagen swapchain liberada para ojo %d", eye);
@@ -1013,18 +1919,54 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
                 projectionViews[eye] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
                 projectionViews[eye].pose = views[eye].pose;
                 projectionViews[eye].fov = views[eye].fov;
-                projectionViews[eye].subImage.swapchain = g_swapchains[eye].swapchain;
+                projectionViews[eye].subImage.swapchain = g_swapchains[eye]->swapchain;
                 projectionViews[eye].subImage.imageRect.offset = {0, 0};
                 projectionViews[eye].subImage.imageRect.extent = {
-                        static_cast<int32_t>(g_swapchains[eye].width),
-                        static_cast<int32_t>(g_swapchains[eye].height)
+                        static_cast<int32_t>(g_swapchains[eye]->width),
+                        static_cast<int32_t>(g_swapchains[eye]->height)
                 };
             }
 
+            // Proteger el slot del anillo hasta que la GPU termine este frame
+            g_uniformRing.endFrame();
+
+            auto submitTime = std::chrono::steady_clock::now();
+            g_latency.mark(kLatencySubmitToPhoton);
+            const double earlyAgeMs = std::chrono::duration<double, std::milli>(submitTime - earlyLocateTime).count();
+            const double lateAgeMs = std::chrono::duration<double, std::milli>(submitTime - lateLocateTime).count();
+            g_poseLatency.frames++;
+            const double weight = 1.0 / static_cast<double>(std::min<uint64_t>(g_poseLatency.frames, 120));
+            g_poseLatency.earlyPoseAgeMs += (earlyAgeMs - g_poseLatency.earlyPoseAgeMs) * weight;
+            g_poseLatency.latePoseAgeMs += (lateAgeMs - g_poseLatency.latePoseAgeMs) * weight;
+            if (g_poseLatency.frames % kPoseLatencyLogInterval == 0) {
+                LOGI("Edad de pose al enviar: %.2f ms (sin late latching: %.2f ms, %llu/%llu frames parcheados)",
+                     g_poseLatency.latePoseAgeMs, g_poseLatency.earlyPoseAgeMs,
+                     static_cast<unsigned long long>(g_poseLatency.latchedFrames),
+                     static_cast<unsigned long long>(g_poseLatency.frames));
+                g_threadRegistry.logStats();
+                g_jobs.logStats();
+                g_frameArenas.logStats();
+                g_drawPackets.logStats();
+                g_glState.logStats();
+            }
+
             // Configurar layer de proyección
             layer.space = g_openxrState.appSpace;
             layer.viewCount = 2;
             layer.views = projectionViews.data();
+            if (passthroughActive) {
+                // Passthrough debajo; la proyección se mezcla por alfa (premultiplicado, fondo a 0)
+                passthroughLayer = g_passthrough.compositionLayer();
+                layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(&passthroughLayer));
+                layer.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+                if (g_capabilities.has(kFeatureAlphaBlend)) {
+                    alphaBlend.srcFactorColor = XR_BLEND_FACTOR_ONE_FB;
+                    alphaBlend.dstFactorColor = XR_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA_FB;
+                    alphaBlend.srcFactorAlpha = XR_BLEND_FACTOR_ONE_FB;
+                    alphaBlend.dstFactorAlpha = XR_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA_FB;
+                    layer.next = &alphaBlend;
+                }
+            }
             layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(&layer));
 
             LOGD("Layer de proyección configurado con %d views", layer.viewCount);
@@ -1040,6 +1982,19 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
         frameEndInfo.layers = layers.data();
 
         bool endFrameResult = CheckXrResult(xrEndFrame(g_openxrState.session, &frameEndInfo), "xrEndFrame");
+        g_latency.endFrame(frameState.predictedDisplayTime);
+        g_frameArenas.endFrame();
+        if (endFrameResult && !layers.empty() && !g_startupTimings.firstFrameLogged) {
+            g_startupTimings.firstFrameLogged = true;
+            const double firstFrameMs = elapsedMs(g_startupTimings.begin);
+            if (g_startupTimings.warm) {
+                LOGI("Reanudación en caliente: primer frame a %.1f ms (arranque en frío: %.1f ms)",
+                     firstFrameMs, g_coldFirstFrameMs);
+            } else {
+                g_coldFirstFrameMs = firstFrameMs;
+                LOGI("Primer frame enviado a %.1f ms del arranque", firstFrameMs);
+            }
+        }
         LOGD("EndFrame completado con %d layers, resultado: %s", frameEndInfo.layerCount, endFrameResult ? "éxito" : "error");
         LOGD("=== FIN FRAME ===");
 
@@ -1056,78 +2011,5 @@ Java_com_example_holamundo2_MainActivity_nativeRunFrame(JNIEnv *env, jobject thi
 
 extern "C" JNIEXPORT void JNICALL
 Java_com_example_holamundo2_MainActivity_nativeShutdown(JNIEnv *env, jobject thiz) {
-    LOGI("=== Cerrando OpenXR ===");
-
-    try {
-        std::lock_guard<std::mutex> lock(g_openxrState.stateMutex);
-
-        // Terminar sesión si está corriendo
-        if (g_openxrState.sessionRunning && g_openxrState.session != XR_NULL_HANDLE) {
-            LOGI("Terminando sesión activa...");
-            XrResult result = xrEndSession(g_openxrState.session);
-            if (XR_FAILED(result)) {
-                LOGE("Error terminando sesión: %d", result);
-            }
-            g_openxrState.sessionRunning = false;
-        }
-
-        // Limpiar swapchains
-        cleanupSwapchains();
-
-        // Limpiar espacio de referencia
-        if (g_openxrState.appSpace != XR_NULL_HANDLE) {
-            XrResult result = xrDestroySpace(g_openxrState.appSpace);
-            if (XR_FAILED(result)) {
-                LOGE("Error destruyendo space: %d", result);
-            }
-            g_openxrState.appSpace = XR_NULL_HANDLE;
-        }
-
-        // Limpiar sesión
-        if (g_openxrState.session != XR_NULL_HANDLE) {
-            XrResult result = xrDestroySession(g_openxrState.session);
-            if (XR_FAILED(result)) {
-                LOGE("Error destruyendo session: %d", result);
-            }
-            g_openxrState.session = XR_NULL_HANDLE;
-        }
-
-        // Limpiar instancia
-        if (g_openxrState.instance != XR_NULL_HANDLE) {
-            XrResult result = xrDestroyInstance(g_openxrState.instance);
-            if (XR_FAILED(result)) {
-                LOGE("Error destruyendo instance: %d", result);
-            }
-            g_openxrState.instance = XR_NULL_HANDLE;
-        }
-
-        // Limpiar recursos EGL (SIN superficie)
-        if (g_openxrState.eglContext != EGL_NO_CONTEXT) {
-            eglMakeCurrent(g_openxrState.eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
-            eglDestroyContext(g_openxrState.eglDisplay, g_openxrState.eglContext);
-            g_openxrState.eglContext = EGL_NO_CONTEXT;
-        }
-        if (g_openxrState.eglDisplay != EGL_NO_DISPLAY) {
-            eglTerminate(g_openxrState.eglDisplay);
-            g_openxrState.eglDisplay = EGL_NO_DISPLAY;
-        }
-        g_openxrState.eglConfig = nullptr;
-
-        // Limpiar OpenXR loader
-        if (g_openxrState.loaderInitialized) {
-            LOGI("Limpiando recursos OpenXR...");
-            g_openxrState.loaderInitialized = false;
-            LOGI("✓ Recursos OpenXR limpiados");
-        }
-
-        // Reset completo del estado
-        g_openxrState.reset();
-
-        LOGI("=== OpenXR cerrado correctamente ===");
-
-    } catch (const std::exception& e) {
-        LOGE("Excepción durante shutdown: %s", e.what());
-    } catch (...) {
-        LOGE("Excepción desconocida durante shutdown");
-    }
-}
\ No newline at end of file
+    shutdownOpenXR();
+}
@@ -0,0 +1,88 @@
+#include "passthrough.h"
+
+#include "native_log.h"
+#include "xr_check.h"
+#include "xr_dispatch.h"
+
+bool Passthrough::initialize(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId, XrSession session) {
+    createPassthrough = dispatch.xrCreatePassthroughFB;
+    destroyPassthrough = dispatch.xrDestroyPassthroughFB;
+    passthroughStart = dispatch.xrPassthroughStartFB;
+    passthroughPause = dispatch.xrPassthroughPauseFB;
+    createLayer = dispatch.xrCreatePassthroughLayerFB;
+    destroyLayer = dispatch.xrDestroyPassthroughLayerFB;
+    layerResume = dispatch.xrPassthroughLayerResumeFB;
+    layerPause = dispatch.xrPassthroughLayerPauseFB;
+    if (!createPassthrough || !destroyPassthrough || !passthroughStart || !passthroughPause ||
+        !createLayer || !destroyLayer || !layerResume || !layerPause) {
+        return false;
+    }
+
+    XrSystemPassthroughProperties2FB passthroughProperties{XR_TYPE_SYSTEM_PASSTHROUGH_PROPERTIES2_FB};
+    XrSystemProperties systemProperties{XR_TYPE_SYSTEM_PROPERTIES};
+    systemProperties.next = &passthroughProperties;
+    if (!CheckXrResult(xrGetSystemProperties(instance, systemId, &systemProperties), "xrGetSystemProperties (passthrough)")) {
+        return false;
+    }
+    if (!(passthroughProperties.capabilities & XR_PASSTHROUGH_CAPABILITY_BIT_FB)) {
+        LOGI("El sistema no soporta passthrough");
+        return false;
+    }
+
+    // Ambos se crean pausados; setRunning() los activa cuando se pide el modo
+    XrPassthroughCreateInfoFB passthroughInfo{XR_TYPE_PASSTHROUGH_CREATE_INFO_FB};
+    if (!CheckXrResult(createPassthrough(session, &passthroughInfo, &passthrough), "xrCreatePassthroughFB")) {
+        return false;
+    }
+
+    XrPassthroughLayerCreateInfoFB layerInfo{XR_TYPE_PASSTHROUGH_LAYER_CREATE_INFO_FB};
+    layerInfo.passthrough = passthrough;
+    layerInfo.purpose = XR_PASSTHROUGH_LAYER_PURPOSE_RECONSTRUCTION_FB;
+    if (!CheckXrResult(createLayer(session, &layerInfo, &layer), "xrCreatePassthroughLayerFB")) {
+        destroy();
+        return false;
+    }
+
+    running = false;
+    LOGI("✓ Passthrough listo");
+    return true;
+}
+
+void Passthrough::destroy() {
+    if (layer != XR_NULL_HANDLE) {
+        destroyLayer(layer);
+        layer = XR_NULL_HANDLE;
+    }
+    if (passthrough != XR_NULL_HANDLE) {
+        destroyPassthrough(passthrough);
+        passthrough = XR_NULL_HANDLE;
+    }
+    running = false;
+}
+
+bool Passthrough::setRunning(bool enabled) {
+    if (!isAvailable() || enabled == running) {
+        return enabled == running;
+    }
+
+    if (enabled) {
+        if (!CheckXrResult(passthroughStart(passthrough), "xrPassthroughStartFB") ||
+            !CheckXrResult(layerResume(layer), "xrPassthroughLayerResumeFB")) {
+            return false;
+        }
+    } else {
+        layerPause(layer);
+        passthroughPause(passthrough);
+    }
+    running = enabled;
+    LOGI("Passthrough %s", running ? "activo" : "pausado");
+    return true;
+}
+
+XrCompositionLayerPassthroughFB Passthrough::compositionLayer() const {
+    XrCompositionLayerPassthroughFB compositionLayer{XR_TYPE_COMPOSITION_LAYER_PASSTHROUGH_FB};
+    compositionLayer.flags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+    compositionLayer.space = XR_NULL_HANDLE;
+    compositionLayer.layerHandle = layer;
+    return compositionLayer;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <openxr/openxr.h>
+
+struct XrDispatch;
+
+// Passthrough de Meta (XR_FB_passthrough) como capa de composición bajo la
+// capa de proyección. Con passthrough activo el fondo de la escena se limpia a
+// alfa 0 y el compositor mezcla la proyección sobre la imagen de las cámaras.
+struct Passthrough {
+    PFN_xrCreatePassthroughFB createPassthrough = nullptr;
+    PFN_xrDestroyPassthroughFB destroyPassthrough = nullptr;
+    PFN_xrPassthroughStartFB passthroughStart = nullptr;
+    PFN_xrPassthroughPauseFB passthroughPause = nullptr;
+    PFN_xrCreatePassthroughLayerFB createLayer = nullptr;
+    PFN_xrDestroyPassthroughLayerFB destroyLayer = nullptr;
+    PFN_xrPassthroughLayerResumeFB layerResume = nullptr;
+    PFN_xrPassthroughLayerPauseFB layerPause = nullptr;
+
+    XrPassthroughFB passthrough = XR_NULL_HANDLE;
+    XrPassthroughLayerFB layer = XR_NULL_HANDLE;
+    bool running = false;
+
+    bool initialize(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId, XrSession session);
+    void destroy();
+    bool isAvailable() const { return layer != XR_NULL_HANDLE; }
+    bool isRunning() const { return running; }
+
+    // Inicia o pausa las cámaras; pausado no tiene coste en el compositor
+    bool setRunning(bool enabled);
+
+    // Capa a enviar antes de la proyección (solo válida si isRunning())
+    XrCompositionLayerPassthroughFB compositionLayer() const;
+};
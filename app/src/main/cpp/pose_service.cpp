@@ -0,0 +1,91 @@
+#include "pose_service.h"
+
+#include "native_log.h"
+#include "xr_check.h"
+#include "xr_dispatch.h"
+
+bool PoseService::initialize(const XrDispatch& dispatch) {
+    locateSpaces = dispatch.xrLocateSpacesKHR;
+    LOGI("✓ Servicio de poses: %s", locateSpaces ? "xrLocateSpacesKHR en lote" : "xrLocateSpace por espacio");
+    return true;
+}
+
+void PoseService::destroy() {
+    spaces.clear();
+    names.clear();
+    for (auto& snapshot : snapshots) {
+        snapshot = PoseSnapshot{};
+    }
+    locateSpaces = nullptr;
+    published = 0;
+    frameIndex = 0;
+}
+
+PoseSpaceId PoseService::registerSpace(XrSpace space, const char* name) {
+    if (space == XR_NULL_HANDLE) {
+        return kInvalidPoseSpace;
+    }
+    spaces.push_back(space);
+    names.emplace_back(name);
+
+    // Reservar aquí para que update() no asigne memoria en el frame
+    for (auto& snapshot : snapshots) {
+        snapshot.locations.resize(spaces.size(), {});
+        snapshot.velocities.resize(spaces.size(), {});
+    }
+    return static_cast<PoseSpaceId>(spaces.size() - 1);
+}
+
+bool PoseService::update(XrSession session, XrSpace baseSpace, XrTime time) {
+    PoseSnapshot& next = snapshots[published ^ 1];
+    next.time = time;
+    next.frameIndex = ++frameIndex;
+
+    const uint32_t count = static_cast<uint32_t>(spaces.size());
+    bool success = true;
+
+    if (count > 0 && locateSpaces) {
+        XrSpacesLocateInfoKHR locateInfo{XR_TYPE_SPACES_LOCATE_INFO_KHR};
+        locateInfo.baseSpace = baseSpace;
+        locateInfo.time = time;
+        locateInfo.spaceCount = count;
+        locateInfo.spaces = spaces.data();
+
+        XrSpaceVelocitiesKHR velocities{XR_TYPE_SPACE_VELOCITIES_KHR};
+        velocities.velocityCount = count;
+        velocities.velocities = next.velocities.data();
+
+        XrSpaceLocationsKHR locations{XR_TYPE_SPACE_LOCATIONS_KHR};
+        locations.next = &velocities;
+        locations.locationCount = count;
+        locations.locations = next.locations.data();
+
+        success = CheckXrResult(locateSpaces(session, &locateInfo, &locations), "xrLocateSpacesKHR");
+    } else {
+        for (uint32_t i = 0; i < count; i++) {
+            XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+            XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+            location.next = &velocity;
+            if (XR_FAILED(xrLocateSpace(spaces[i], baseSpace, time, &location))) {
+                location.locationFlags = 0;
+                velocity.velocityFlags = 0;
+                success = false;
+            }
+            next.locations[i] = {location.locationFlags, location.pose};
+            next.velocities[i] = {velocity.velocityFlags, velocity.linearVelocity, velocity.angularVelocity};
+        }
+    }
+
+    if (!success) {
+        // Un fallo deja todas las poses inválidas en vez de mezclar datos de frames distintos
+        for (auto& location : next.locations) {
+            location.locationFlags = 0;
+        }
+        for (auto& velocity : next.velocities) {
+            velocity.velocityFlags = 0;
+        }
+    }
+
+    published ^= 1;
+    return success;
+}
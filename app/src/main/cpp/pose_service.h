@@ -0,0 +1,52 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct XrDispatch;
+
+using PoseSpaceId = uint32_t;
+constexpr PoseSpaceId kInvalidPoseSpace = UINT32_MAX;
+
+// Poses de todos los espacios registrados en un instante concreto.
+// Se publica una vez por frame y no cambia hasta el siguiente update().
+struct PoseSnapshot {
+    XrTime time = 0;
+    uint64_t frameIndex = 0;
+    std::vector<XrSpaceLocationData> locations;   // Indexado por PoseSpaceId
+    std::vector<XrSpaceVelocityData> velocities;
+
+    bool isValid(PoseSpaceId id) const {
+        constexpr XrSpaceLocationFlags kValid =
+                XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+        return id < locations.size() && (locations[id].locationFlags & kValid) == kValid;
+    }
+    const XrPosef& pose(PoseSpaceId id) const { return locations[id].pose; }
+};
+
+// Servicio de poses: los subsistemas registran sus espacios una vez y todos se
+// resuelven en una sola llamada a xrLocateSpacesKHR por frame. Sin
+// XR_KHR_locate_spaces se recorre la lista con xrLocateSpace.
+struct PoseService {
+    std::vector<XrSpace> spaces;
+    std::vector<std::string> names;
+    PFN_xrLocateSpacesKHR locateSpaces = nullptr;
+
+    bool initialize(const XrDispatch& dispatch);
+    void destroy();
+
+    // No toma posesión del espacio; el llamador lo destruye tras destroy()
+    PoseSpaceId registerSpace(XrSpace space, const char* name);
+
+    // Localiza todos los espacios respecto a baseSpace y publica un snapshot nuevo
+    bool update(XrSession session, XrSpace baseSpace, XrTime time);
+
+    const PoseSnapshot& snapshot() const { return snapshots[published]; }
+
+private:
+    PoseSnapshot snapshots[2];   // Publicado + en construcción
+    uint32_t published = 0;
+    uint64_t frameIndex = 0;
+};
@@ -0,0 +1,136 @@
+#include "render_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "native_log.h"
+
+namespace {
+
+constexpr uint32_t kRadixBits = 8;
+constexpr uint32_t kRadixBuckets = 1u << kRadixBits;
+constexpr uint32_t kRadixPasses = 64 / kRadixBits;
+constexpr uint32_t kDepthMask = 0xFFFFFFu;
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+uint32_t quantizeRenderDepth(float viewDepth) {
+    if (!(viewDepth > 0.0f)) {
+        return 0;   // Detrás de la cámara o NaN: lo más cercano
+    }
+    uint32_t bits;
+    memcpy(&bits, &viewDepth, sizeof(bits));
+    // Sin signo quedan 31 bits; los 24 altos conservan exponente y 16 bits de mantisa
+    return std::min(bits >> 7, kDepthMask);
+}
+
+uint64_t makeRenderKey(RenderLayer layer, uint32_t program, uint32_t material, float viewDepth) {
+    const uint64_t layerBits = static_cast<uint64_t>(layer & 0xFFu) << 56;
+    const uint64_t state = (static_cast<uint64_t>(program & 0xFFFFu) << 16) | (material & 0xFFFFu);
+    const uint32_t depth = quantizeRenderDepth(viewDepth);
+    if (layer == kRenderLayerTransparent) {
+        return layerBits | (static_cast<uint64_t>(kDepthMask - depth) << 32) | state;
+    }
+    return layerBits | (state << 24) | depth;
+}
+
+RenderQueueEntry* radixSortRenderQueue(RenderQueueEntry* entries, RenderQueueEntry* scratch, uint32_t count) {
+    if (count < 2) {
+        return entries;
+    }
+
+    uint32_t histograms[kRadixPasses][kRadixBuckets] = {};
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t key = entries[i].key;
+        for (uint32_t pass = 0; pass < kRadixPasses; pass++) {
+            histograms[pass][key & (kRadixBuckets - 1)]++;
+            key >>= kRadixBits;
+        }
+    }
+
+    RenderQueueEntry* source = entries;
+    RenderQueueEntry* destination = scratch;
+    for (uint32_t pass = 0; pass < kRadixPasses; pass++) {
+        uint32_t* histogram = histograms[pass];
+        const uint32_t shift = pass * kRadixBits;
+        // Todas las claves comparten este byte: la pasada no cambiaría nada
+        if (histogram[(source[0].key >> shift) & (kRadixBuckets - 1)] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < kRadixBuckets; bucket++) {
+            const uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            const RenderQueueEntry& entry = source[i];
+            destination[histogram[(entry.key >> shift) & (kRadixBuckets - 1)]++] = entry;
+        }
+        std::swap(source, destination);
+    }
+    return source;
+}
+
+void runRenderQueueBenchmark() {
+    constexpr uint32_t kSizes[] = {1000, 10000, 100000, 1000000};
+    constexpr uint32_t kRuns = 5;
+    constexpr uint32_t kPrograms = 16;
+    constexpr uint32_t kMaterials = 256;
+
+    LOGI("=== Benchmark de la cola de render: radix sort frente a std::stable_sort ===");
+
+    const uint32_t maxCount = kSizes[sizeof(kSizes) / sizeof(kSizes[0]) - 1];
+    std::unique_ptr<RenderQueueEntry[]> input(new RenderQueueEntry[maxCount]);
+    std::unique_ptr<RenderQueueEntry[]> work(new RenderQueueEntry[maxCount]);
+    std::unique_ptr<RenderQueueEntry[]> scratch(new RenderQueueEntry[maxCount]);
+
+    // Escena representativa: 80% opacos, el resto transparentes, profundidades de 0.1 a 100 m
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> depthDistribution(0.1f, 100.0f);
+    for (uint32_t i = 0; i < maxCount; i++) {
+        const RenderLayer layer = random() % 5 == 0 ? kRenderLayerTransparent : kRenderLayerOpaque;
+        input[i].key = makeRenderKey(layer, 1 + random() % kPrograms, 1 + random() % kMaterials,
+                                     depthDistribution(random));
+        input[i].index = i;
+    }
+
+    auto keyLess = [](const RenderQueueEntry& a, const RenderQueueEntry& b) { return a.key < b.key; };
+    for (uint32_t count : kSizes) {
+        double radixMs = 0.0;
+        double stdMs = 0.0;
+        bool sorted = true;
+        // La primera pasada calienta cachés y no cuenta
+        for (uint32_t run = 0; run <= kRuns; run++) {
+            memcpy(work.get(), input.get(), sizeof(RenderQueueEntry) * count);
+            auto start = std::chrono::steady_clock::now();
+            const RenderQueueEntry* result = radixSortRenderQueue(work.get(), scratch.get(), count);
+            const double ms = msSince(start);
+            if (run == 1 || (run > 1 && ms < radixMs)) {
+                radixMs = ms;
+            }
+            sorted = sorted && std::is_sorted(result, result + count, keyLess);
+
+            memcpy(work.get(), input.get(), sizeof(RenderQueueEntry) * count);
+            start = std::chrono::steady_clock::now();
+            std::stable_sort(work.get(), work.get() + count, keyLess);
+            const double stdTime = msSince(start);
+            if (run == 1 || (run > 1 && stdTime < stdMs)) {
+                stdMs = stdTime;
+            }
+        }
+        if (!sorted) {
+            LOGE("Radix sort de la cola de render produjo un orden incorrecto con %u entradas", count);
+        }
+        LOGI("  %7u entradas: radix %.3f ms, std::stable_sort %.3f ms (x%.2f)",
+             count, radixMs, stdMs, radixMs > 0.0 ? stdMs / radixMs : 0.0);
+    }
+}
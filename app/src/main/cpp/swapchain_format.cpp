@@ -0,0 +1,138 @@
+#include "swapchain_format.h"
+
+#include <jni.h>
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+#include <openxr/openxr_platform.h>
+#include <algorithm>
+
+#include "native_log.h"
+#include "xr_check.h"
+#include "xr_dispatch.h"
+
+namespace {
+
+struct FormatPreference {
+    GLenum format;
+    const char* name;
+    const char* reason;
+};
+
+// sRGB primero: el blending y el muestreo en el compositor son correctos sin
+// convertir, y el runtime no tiene que reinterpretar un buffer lineal
+const FormatPreference kColorPreferences[] = {
+        {GL_SRGB8_ALPHA8, "GL_SRGB8_ALPHA8", "sRGB con alpha, sin conversión en el compositor"},
+        {GL_RGBA8, "GL_RGBA8", "sin sRGB, el compositor interpreta el buffer como lineal"},
+        {GL_RGB8, "GL_RGB8", "sin sRGB ni alpha"},
+};
+
+// 24 bits bastan para la escena; DEPTH24_STENCIL8 es el formato nativo de los
+// GPU móviles y deja stencil disponible sin coste extra
+const FormatPreference kDepthPreferences[] = {
+        {GL_DEPTH24_STENCIL8, "GL_DEPTH24_STENCIL8", "formato nativo del tiler, incluye stencil"},
+        {GL_DEPTH_COMPONENT24, "GL_DEPTH_COMPONENT24", "sin stencil"},
+        {GL_DEPTH_COMPONENT32F, "GL_DEPTH_COMPONENT32F", "float, más ancho de banda"},
+        {GL_DEPTH_COMPONENT16, "GL_DEPTH_COMPONENT16", "precisión reducida"},
+};
+
+const char* colorSpaceName(XrColorSpaceFB colorSpace) {
+    switch (colorSpace) {
+        case XR_COLOR_SPACE_UNMANAGED_FB: return "sin gestionar";
+        case XR_COLOR_SPACE_REC2020_FB: return "Rec.2020";
+        case XR_COLOR_SPACE_REC709_FB: return "Rec.709";
+        case XR_COLOR_SPACE_RIFT_CV1_FB: return "Rift CV1";
+        case XR_COLOR_SPACE_RIFT_S_FB: return "Rift S";
+        case XR_COLOR_SPACE_QUEST_FB: return "Quest";
+        case XR_COLOR_SPACE_P3_FB: return "P3";
+        case XR_COLOR_SPACE_ADOBE_RGB_FB: return "Adobe RGB";
+        default: return "desconocido";
+    }
+}
+
+SwapchainFormatChoice g_lastChoice;
+bool g_choiceLogged = false;
+
+} // namespace
+
+SwapchainFormatChoice chooseSwapchainFormats(const std::vector<int64_t>& runtimeFormats) {
+    auto supports = [&runtimeFormats](GLenum format) {
+        return std::find(runtimeFormats.begin(), runtimeFormats.end(), static_cast<int64_t>(format)) != runtimeFormats.end();
+    };
+
+    SwapchainFormatChoice choice;
+    const FormatPreference* color = nullptr;
+    for (const FormatPreference& preference : kColorPreferences) {
+        if (supports(preference.format)) {
+            color = &preference;
+            break;
+        }
+    }
+    if (color) {
+        choice.color = color->format;
+        choice.colorIsSrgb = color->format == GL_SRGB8_ALPHA8;
+    } else if (!runtimeFormats.empty()) {
+        choice.color = runtimeFormats[0];
+    }
+
+    // El depth no se envía al compositor, así que puede usar cualquier formato
+    // renderizable aunque el runtime no lo liste
+    const FormatPreference* depth = &kDepthPreferences[0];
+    for (const FormatPreference& preference : kDepthPreferences) {
+        if (supports(preference.format)) {
+            depth = &preference;
+            break;
+        }
+    }
+    choice.depth = depth->format;
+
+    // La política se evalúa en cada sesión pero solo se registra si cambia
+    if (!g_choiceLogged || choice.color != g_lastChoice.color || choice.depth != g_lastChoice.depth) {
+        if (color) {
+            LOGI("✓ Formato de color: %s (%s)", color->name, color->reason);
+        } else {
+            LOGI("Formato de color: 0x%08llX (primero del runtime, ninguno preferido disponible)",
+                 (long long)choice.color);
+        }
+        LOGI("✓ Formato de depth: %s (%s)", depth->name, depth->reason);
+        if (choice.colorIsSrgb) {
+            LOGI("  Los shaders escriben color lineal; la codificación sRGB la hace el hardware");
+        }
+        g_lastChoice = choice;
+        g_choiceLogged = true;
+    }
+    return choice;
+}
+
+void applyContentColorSpace(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId, XrSession session) {
+    if (!dispatch.xrEnumerateColorSpacesFB || !dispatch.xrSetColorSpaceFB) {
+        LOGI("XR_FB_color_space no disponible, el compositor usa su espacio por defecto");
+        return;
+    }
+
+    XrSystemColorSpacePropertiesFB colorSpaceProperties{XR_TYPE_SYSTEM_COLOR_SPACE_PROPERTIES_FB};
+    XrSystemProperties systemProperties{XR_TYPE_SYSTEM_PROPERTIES};
+    systemProperties.next = &colorSpaceProperties;
+    if (XR_SUCCEEDED(xrGetSystemProperties(instance, systemId, &systemProperties))) {
+        LOGI("Espacio de color nativo del panel: %s", colorSpaceName(colorSpaceProperties.colorSpace));
+    }
+
+    uint32_t count = 0;
+    if (!CheckXrResult(dispatch.xrEnumerateColorSpacesFB(session, 0, &count, nullptr), "xrEnumerateColorSpacesFB (count)")) {
+        return;
+    }
+    std::vector<XrColorSpaceFB> colorSpaces(count);
+    if (!CheckXrResult(dispatch.xrEnumerateColorSpacesFB(session, count, &count, colorSpaces.data()),
+                       "xrEnumerateColorSpacesFB (data)")) {
+        return;
+    }
+    colorSpaces.resize(count);
+
+    // El contenido se autora en sRGB, que comparte primarios con Rec.709
+    if (std::find(colorSpaces.begin(), colorSpaces.end(), XR_COLOR_SPACE_REC709_FB) == colorSpaces.end()) {
+        LOGI("Rec.709 no soportado por el runtime, se mantiene el espacio por defecto");
+        return;
+    }
+    if (CheckXrResult(dispatch.xrSetColorSpaceFB(session, XR_COLOR_SPACE_REC709_FB), "xrSetColorSpaceFB")) {
+        LOGI("✓ Espacio de color del contenido: Rec.709");
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cstdint>
+#include <vector>
+
+struct XrDispatch;
+
+// Formatos elegidos para los swapchains de color y el depth de cada ojo
+struct SwapchainFormatChoice {
+    int64_t color = 0;
+    int64_t depth = 0;           // 0 si no hay depth
+    bool colorIsSrgb = false;    // Los shaders escriben lineal; la conversión la hace el hardware
+};
+
+// Ordena los formatos del runtime por preferencia: sRGB para color (sin pasada
+// de conversión en el compositor ni gamma manual en los shaders) y el depth
+// más barato que sea preciso. Registra la elección y el motivo una sola vez.
+SwapchainFormatChoice chooseSwapchainFormats(const std::vector<int64_t>& runtimeFormats);
+
+// XR_FB_color_space: declara que el contenido está en Rec.709 (primarios sRGB)
+// para que el compositor lo mapee al panel. No hace nada sin la extensión.
+void applyContentColorSpace(const XrDispatch& dispatch, XrInstance instance, XrSystemId systemId, XrSession session);
@@ -0,0 +1,202 @@
+#include "swapchain_pool.h"
+
+#include <algorithm>
+
+#include "native_log.h"
+#include "xr_check.h"
+
+const std::vector<int64_t>& SwapchainPool::supportedFormats(XrSession session) {
+    if (formatsQueried) {
+        return formats;
+    }
+
+    uint32_t formatCount = 0;
+    if (!CheckXrResult(xrEnumerateSwapchainFormats(session, 0, &formatCount, nullptr),
+                       "xrEnumerateSwapchainFormats (count)")) {
+        formats.clear();
+        return formats;
+    }
+    formats.resize(formatCount);
+    if (!CheckXrResult(xrEnumerateSwapchainFormats(session, formatCount, &formatCount, formats.data()),
+                       "xrEnumerateSwapchainFormats (data)")) {
+        formats.clear();
+        return formats;
+    }
+    formats.resize(formatCount);
+    formatsQueried = true;
+
+    LOGI("Formatos de swapchain soportados (%u):", formatCount);
+    for (auto format : formats) {
+        LOGD("  - Format: 0x%08llX", (long long)format);
+    }
+    return formats;
+}
+
+SwapchainInfo* SwapchainPool::acquire(XrSession session, const SwapchainDesc& desc) {
+    for (auto& entry : entries) {
+        if (!entry->inUse && entry->session == session && entry->desc == desc) {
+            entry->inUse = true;
+            stats.hits++;
+            return entry.get();
+        }
+    }
+    stats.misses++;
+
+    auto entry = std::make_unique<SwapchainInfo>();
+    entry->desc = desc;
+    entry->session = session;
+
+    XrSwapchainCreateInfo createInfo{XR_TYPE_SWAPCHAIN_CREATE_INFO};
+    createInfo.width = desc.width;
+    createInfo.height = desc.height;
+    createInfo.format = desc.format;
+    createInfo.mipCount = 1;
+    createInfo.faceCount = 1;
+    createInfo.arraySize = desc.arraySize;
+    createInfo.sampleCount = desc.sampleCount;
+    createInfo.usageFlags = desc.usageFlags;
+
+    if (!CheckXrResult(xrCreateSwapchain(session, &createInfo, &entry->swapchain), "xrCreateSwapchain")) {
+        return nullptr;
+    }
+    entry->width = desc.width;
+    entry->height = desc.height;
+
+    uint32_t imageCount = 0;
+    if (!CheckXrResult(xrEnumerateSwapchainImages(entry->swapchain, 0, &imageCount, nullptr),
+                       "xrEnumerateSwapchainImages (count)")) {
+        destroySwapchain(*entry);
+        return nullptr;
+    }
+    entry->images.resize(imageCount, {XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_ES_KHR});
+    if (!CheckXrResult(xrEnumerateSwapchainImages(entry->swapchain, imageCount, &imageCount,
+                                                  reinterpret_cast<XrSwapchainImageBaseHeader*>(entry->images.data())),
+                       "xrEnumerateSwapchainImages (data)")) {
+        destroySwapchain(*entry);
+        return nullptr;
+    }
+
+    if (!createFramebuffers(*entry)) {
+        destroySwapchain(*entry);
+        return nullptr;
+    }
+
+    entry->inUse = true;
+    entries.push_back(std::move(entry));
+    return entries.back().get();
+}
+
+void SwapchainPool::release(SwapchainInfo* swapchain) {
+    if (swapchain) {
+        swapchain->inUse = false;
+    }
+}
+
+void SwapchainPool::releaseSession(XrSession session) {
+    for (auto& entry : entries) {
+        if (entry->session == session) {
+            destroySwapchain(*entry);
+        }
+    }
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const std::unique_ptr<SwapchainInfo>& entry) { return entry->swapchain == XR_NULL_HANDLE; }),
+                  entries.end());
+}
+
+void SwapchainPool::destroy() {
+    for (auto& entry : entries) {
+        destroySwapchain(*entry);
+    }
+    entries.clear();
+    if (!freeFramebuffers.empty()) {
+        glDeleteFramebuffers(static_cast<GLsizei>(freeFramebuffers.size()), freeFramebuffers.data());
+        freeFramebuffers.clear();
+    }
+    formats.clear();
+    formatsQueried = false;
+}
+
+void SwapchainPool::logStats() const {
+    LOGI("Pool de swapchains: %llu reutilizados, %llu creados, %llu framebuffers reciclados",
+         (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+         (unsigned long long)stats.framebuffersReused);
+}
+
+bool SwapchainPool::createFramebuffers(SwapchainInfo& swapchain) {
+    const size_t imageCount = swapchain.images.size();
+    const size_t reused = std::min(imageCount, freeFramebuffers.size());
+    swapchain.framebuffers.assign(freeFramebuffers.end() - reused, freeFramebuffers.end());
+    freeFramebuffers.resize(freeFramebuffers.size() - reused);
+    stats.framebuffersReused += reused;
+
+    swapchain.framebuffers.resize(imageCount, 0);
+    if (imageCount > reused) {
+        glGenFramebuffers(static_cast<GLsizei>(imageCount - reused), swapchain.framebuffers.data() + reused);
+    }
+
+    // El depth no se envía al compositor: un renderbuffer basta y se reutiliza
+    // en todas las imágenes porque solo una está en vuelo en el render
+    if (swapchain.desc.depthFormat != 0) {
+        const GLenum depthFormat = static_cast<GLenum>(swapchain.desc.depthFormat);
+        swapchain.depthAttachment = (depthFormat == GL_DEPTH24_STENCIL8 || depthFormat == GL_DEPTH32F_STENCIL8)
+                                    ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+        glGenRenderbuffers(1, &swapchain.depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, swapchain.depthBuffer);
+        if (swapchain.desc.sampleCount > 1) {
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, static_cast<GLsizei>(swapchain.desc.sampleCount), depthFormat,
+                                             static_cast<GLsizei>(swapchain.width), static_cast<GLsizei>(swapchain.height));
+        } else {
+            glRenderbufferStorage(GL_RENDERBUFFER, depthFormat,
+                                  static_cast<GLsizei>(swapchain.width), static_cast<GLsizei>(swapchain.height));
+        }
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    }
+
+    // Adjuntar cada imagen una sola vez; el render solo hace glBindFramebuffer
+    for (size_t i = 0; i < imageCount; i++) {
+        glBindFramebuffer(GL_FRAMEBUFFER, swapchain.framebuffers[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, swapchain.images[i].image, 0);
+        if (swapchain.depthBuffer != 0) {
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, swapchain.depthAttachment, GL_RENDERBUFFER, swapchain.depthBuffer);
+        }
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            LOGE("Framebuffer incompleto para la imagen %zu del swapchain: 0x%x", i, status);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            return false;
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
+
+void SwapchainPool::destroySwapchain(SwapchainInfo& swapchain) {
+    // Los nombres de framebuffer sobreviven al swapchain y se reutilizan en el siguiente
+    if (!swapchain.framebuffers.empty()) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        for (GLuint framebuffer : swapchain.framebuffers) {
+            if (framebuffer != 0) {
+                glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+                if (swapchain.depthBuffer != 0) {
+                    glFramebufferRenderbuffer(GL_FRAMEBUFFER, swapchain.depthAttachment, GL_RENDERBUFFER, 0);
+                }
+                freeFramebuffers.push_back(framebuffer);
+            }
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        swapchain.framebuffers.clear();
+    }
+    if (swapchain.depthBuffer != 0) {
+        glDeleteRenderbuffers(1, &swapchain.depthBuffer);
+        swapchain.depthBuffer = 0;
+        swapchain.depthAttachment = 0;
+    }
+    if (swapchain.swapchain != XR_NULL_HANDLE) {
+        xrDestroySwapchain(swapchain.swapchain);
+        swapchain.swapchain = XR_NULL_HANDLE;
+    }
+    swapchain.images.clear();
+    swapchain.width = swapchain.height = 0;
+    swapchain.inUse = false;
+}
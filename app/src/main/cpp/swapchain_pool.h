@@ -0,0 +1,78 @@
+#pragma once
+
+#include <jni.h>
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Clave del pool: dos swapchains con la misma descripción son intercambiables
+struct SwapchainDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    int64_t format = 0;
+    uint32_t sampleCount = 1;
+    uint32_t arraySize = 1;
+    XrSwapchainUsageFlags usageFlags = 0;
+    int64_t depthFormat = 0;   // Renderbuffer de depth propio (0 = sin depth)
+
+    bool operator==(const SwapchainDesc& other) const {
+        return width == other.width && height == other.height && format == other.format &&
+               sampleCount == other.sampleCount && arraySize == other.arraySize &&
+               usageFlags == other.usageFlags && depthFormat == other.depthFormat;
+    }
+};
+
+// Swapchain con sus imágenes y un framebuffer ya configurado por imagen
+struct SwapchainInfo {
+    SwapchainDesc desc;
+    XrSwapchain swapchain = XR_NULL_HANDLE;
+    XrSession session = XR_NULL_HANDLE;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<XrSwapchainImageOpenGLESKHR> images;
+    std::vector<GLuint> framebuffers;   // Indexado como images
+    GLuint depthBuffer = 0;             // Compartido por todas las imágenes del swapchain
+    GLenum depthAttachment = 0;         // GL_DEPTH_ATTACHMENT o GL_DEPTH_STENCIL_ATTACHMENT
+    bool inUse = false;
+};
+
+struct SwapchainPoolStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t framebuffersReused = 0;
+};
+
+// Pool de swapchains por instancia. Los swapchains son hijos de la sesión, así
+// que solo se reciclan dentro de ella; al cambiar de sesión se conservan los
+// nombres de framebuffer y la lista de formatos soportados.
+struct SwapchainPool {
+    SwapchainPoolStats stats;
+
+    // Formatos soportados; se consultan al runtime una vez por instancia
+    const std::vector<int64_t>& supportedFormats(XrSession session);
+
+    // Devuelve un swapchain libre compatible o crea uno nuevo (nullptr si falla)
+    SwapchainInfo* acquire(XrSession session, const SwapchainDesc& desc);
+    void release(SwapchainInfo* swapchain);
+
+    // Destruye los swapchains de la sesión (antes de xrDestroySession)
+    void releaseSession(XrSession session);
+
+    // Cambio de instancia o cierre: lo libera todo, incluida la caché de formatos
+    void destroy();
+
+    void logStats() const;
+
+private:
+    bool createFramebuffers(SwapchainInfo& swapchain);
+    void destroySwapchain(SwapchainInfo& swapchain);
+
+    std::vector<std::unique_ptr<SwapchainInfo>> entries;
+    std::vector<GLuint> freeFramebuffers;
+    std::vector<int64_t> formats;
+    bool formatsQueried = false;
+};
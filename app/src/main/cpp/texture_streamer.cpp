@@ -0,0 +1,346 @@
+#include "texture_streamer.h"
+
+#include <GLES2/gl2ext.h>
+#include <algorithm>
+#include <cstring>
+
+#include "gl_state_cache.h"
+#include "native_log.h"
+#include "upload_worker.h"
+
+namespace {
+
+// Cabecera KTX2 (especificación Khronos KTX 2.0, sección 3)
+struct Ktx2Header {
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+struct Ktx2LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+static_assert(sizeof(Ktx2Header) == 80, "Cabecera KTX2 debe ocupar 80 bytes");
+
+constexpr uint8_t kKtx2Identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// VK_FORMAT_ASTC_4x4_UNORM_BLOCK .. VK_FORMAT_ASTC_12x12_SRGB_BLOCK (UNORM/SRGB alternados)
+constexpr uint32_t kVkFormatAstcFirst = 157;
+constexpr uint32_t kVkFormatAstcLast = 184;
+
+// Los mips de hasta este tamaño se suben al cargar, sin esperar al streaming
+constexpr uint32_t kInitialLevelMaxDimension = 64;
+
+// Frames sin uso tras los que una textura deja de recibir mips nuevos
+constexpr uint64_t kStreamingIdleFrames = 90;
+
+GLenum astcInternalFormat(uint32_t vkFormat) {
+    if (vkFormat < kVkFormatAstcFirst || vkFormat > kVkFormatAstcLast) {
+        return 0;
+    }
+    const uint32_t blockIndex = (vkFormat - kVkFormatAstcFirst) / 2;
+    const bool srgb = (vkFormat - kVkFormatAstcFirst) % 2 == 1;
+    return (srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR : GL_COMPRESSED_RGBA_ASTC_4x4_KHR) + blockIndex;
+}
+
+} // namespace
+
+bool TextureStreamer::initialize(uint64_t gpuBudget, uint64_t uploadBudget) {
+    gpuBudgetBytes = gpuBudget;
+    uploadBudgetPerFrame = uploadBudget;
+
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    astcSupported = extensions && strstr(extensions, "GL_KHR_texture_compression_astc_ldr") != nullptr;
+    if (!astcSupported) {
+        LOGE("✗ GL_KHR_texture_compression_astc_ldr NO disponible");
+        return false;
+    }
+
+    LOGI("✓ Streaming de texturas ASTC: presupuesto GPU %llu MB, subida %llu KB/frame",
+         static_cast<unsigned long long>(gpuBudgetBytes >> 20),
+         static_cast<unsigned long long>(uploadBudgetPerFrame >> 10));
+    return true;
+}
+
+void TextureStreamer::cleanup() {
+    for (auto& texture : textures) {
+        if (texture.texture != 0) {
+            glDeleteTextures(1, &texture.texture);
+            texture.texture = 0;
+        }
+        texture.file.reset();
+    }
+    textures.clear();
+    stats = TextureStreamStats{};
+}
+
+TextureHandle TextureStreamer::load(AAssetManager* assetManager, const char* path) {
+    if (!astcSupported) {
+        return kInvalidTexture;
+    }
+
+    auto file = std::make_unique<MappedAsset>();
+    if (!file->open(assetManager, path)) {
+        return kInvalidTexture;
+    }
+
+    if (file->size < sizeof(Ktx2Header)) {
+        LOGE("Textura %s demasiado pequeña", path);
+        return kInvalidTexture;
+    }
+
+    Ktx2Header header;
+    memcpy(&header, file->data, sizeof(header));
+    if (memcmp(header.identifier, kKtx2Identifier, sizeof(kKtx2Identifier)) != 0) {
+        LOGE("Textura %s no es KTX2", path);
+        return kInvalidTexture;
+    }
+
+    GLenum internalFormat = astcInternalFormat(header.vkFormat);
+    if (internalFormat == 0 || header.supercompressionScheme != 0 ||
+        header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1) {
+        LOGE("Textura %s: solo se soportan texturas 2D ASTC sin supercompresión (vkFormat %u)",
+             path, header.vkFormat);
+        return kInvalidTexture;
+    }
+
+    const uint32_t levelCount = std::max(header.levelCount, 1u);
+    if (sizeof(Ktx2Header) + levelCount * sizeof(Ktx2LevelIndex) > file->size) {
+        LOGE("Índice de niveles de %s fuera de rango", path);
+        return kInvalidTexture;
+    }
+
+    StreamedTexture texture;
+    texture.path = path;
+    texture.internalFormat = internalFormat;
+    texture.levels.resize(levelCount);
+    for (uint32_t level = 0; level < levelCount; level++) {
+        Ktx2LevelIndex index;
+        memcpy(&index, file->data + sizeof(Ktx2Header) + level * sizeof(Ktx2LevelIndex), sizeof(index));
+        if (index.byteOffset > file->size || index.byteLength > file->size - index.byteOffset) {
+            LOGE("Mip %u de %s fuera de rango", level, path);
+            return kInvalidTexture;
+        }
+        texture.levels[level].offset = index.byteOffset;
+        texture.levels[level].size = index.byteLength;
+        texture.levels[level].width = std::max(header.pixelWidth >> level, 1u);
+        texture.levels[level].height = std::max(header.pixelHeight >> level, 1u);
+    }
+    texture.file = std::move(file);
+    texture.residentBase = levelCount;
+    texture.targetBase = 0;
+    texture.lastUsedFrame = frameIndex;
+
+    glGenTextures(1, &texture.texture);
+    glBindTexture(GL_TEXTURE_2D, texture.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount - 1));
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Mips más pequeños primero: la textura es utilizable desde el primer frame
+    uint32_t level = levelCount;
+    while (level > 0) {
+        const TextureLevel& next = texture.levels[level - 1];
+        const bool isSmallest = level == levelCount;
+        if (!isSmallest && std::max(next.width, next.height) > kInitialLevelMaxDimension) {
+            break;
+        }
+        if (!makeRoom(next.size, nullptr) || !uploadLevel(texture, level - 1)) {
+            break;
+        }
+        level--;
+    }
+
+    if (texture.residentBase == levelCount) {
+        LOGE("No se pudo subir ningún mip de %s", path);
+        glDeleteTextures(1, &texture.texture);
+        return kInvalidTexture;
+    }
+
+    LOGI("✓ Textura %s: %ux%u, %u mips (residentes desde el %u)",
+         path, header.pixelWidth, header.pixelHeight, levelCount, texture.residentBase);
+
+    textures.push_back(std::move(texture));
+    return static_cast<TextureHandle>(textures.size() - 1);
+}
+
+void TextureStreamer::touch(TextureHandle handle, uint32_t maxResolutionLevel) {
+    if (handle < 0 || static_cast<size_t>(handle) >= textures.size()) {
+        return;
+    }
+    StreamedTexture& texture = textures[handle];
+    texture.lastUsedFrame = frameIndex;
+    texture.targetBase = std::min(maxResolutionLevel, texture.levelCount() - 1);
+}
+
+void TextureStreamer::bind(GlStateCache& state, TextureHandle handle, GLuint unit) const {
+    const bool valid = handle >= 0 && static_cast<size_t>(handle) < textures.size();
+    state.bindTexture(unit, GL_TEXTURE_2D, valid ? textures[handle].texture : 0);
+}
+
+void TextureStreamer::update() {
+    frameIndex++;
+    stats.uploadedBytesThisFrame = 0;
+    stats.uploadsThisFrame = 0;
+    stats.evictionsThisFrame = 0;
+
+    // Prioridad: texturas usadas más recientemente y con menos resolución residente
+    std::vector<StreamedTexture*> pending;
+    for (auto& texture : textures) {
+        if (!texture.uploadInFlight && texture.residentBase > texture.targetBase &&
+            texture.lastUsedFrame + kStreamingIdleFrames >= frameIndex) {
+            pending.push_back(&texture);
+        }
+    }
+    std::sort(pending.begin(), pending.end(), [](const StreamedTexture* a, const StreamedTexture* b) {
+        if (a->lastUsedFrame != b->lastUsedFrame) {
+            return a->lastUsedFrame > b->lastUsedFrame;
+        }
+        return a->residentBase > b->residentBase;
+    });
+
+    for (StreamedTexture* texture : pending) {
+        const uint32_t level = texture->residentBase - 1;
+        const uint64_t size = texture->levels[level].size;
+
+        // Siempre se permite al menos una subida por frame aunque el mip supere el presupuesto
+        if (stats.uploadsThisFrame > 0 && stats.uploadedBytesThisFrame + size > uploadBudgetPerFrame) {
+            continue;
+        }
+        if (!makeRoom(size, texture)) {
+            continue;
+        }
+        const bool uploaded = uploadWorker && uploadWorker->isRunning()
+                              ? uploadLevelAsync(static_cast<size_t>(texture - textures.data()), level)
+                              : uploadLevel(*texture, level);
+        if (uploaded) {
+            stats.uploadsThisFrame++;
+            stats.uploadedBytesThisFrame += size;
+        }
+    }
+}
+
+bool TextureStreamer::uploadLevel(StreamedTexture& texture, uint32_t level) {
+    const TextureLevel& mip = texture.levels[level];
+
+    glBindTexture(GL_TEXTURE_2D, texture.texture);
+    glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), texture.internalFormat,
+                           static_cast<GLsizei>(mip.width), static_cast<GLsizei>(mip.height), 0,
+                           static_cast<GLsizei>(mip.size), texture.file->data + mip.offset);
+    GLenum glError = glGetError();
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (glError != GL_NO_ERROR) {
+        LOGE("Error subiendo mip %u de %s: 0x%x", level, texture.path.c_str(), glError);
+        return false;
+    }
+
+    stats.residentBytes += mip.size;
+    commitLevel(texture, level);
+    return true;
+}
+
+bool TextureStreamer::uploadLevelAsync(size_t textureIndex, uint32_t level) {
+    StreamedTexture& texture = textures[textureIndex];
+    const TextureLevel mip = texture.levels[level];
+    const GLuint textureId = texture.texture;
+    const GLenum internalFormat = texture.internalFormat;
+    const uint8_t* data = texture.file->data + mip.offset;
+
+    // Se reserva la memoria ya, para que el presupuesto cuente la subida en vuelo
+    texture.uploadInFlight = true;
+    stats.residentBytes += mip.size;
+
+    uploadWorker->submit(
+            [=]() {
+                glBindTexture(GL_TEXTURE_2D, textureId);
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), internalFormat,
+                                       static_cast<GLsizei>(mip.width), static_cast<GLsizei>(mip.height), 0,
+                                       static_cast<GLsizei>(mip.size), data);
+                GLenum glError = glGetError();
+                glBindTexture(GL_TEXTURE_2D, 0);
+                return glError == GL_NO_ERROR;
+            },
+            [this, textureIndex, level, size = mip.size](bool success) {
+                StreamedTexture& done = textures[textureIndex];
+                done.uploadInFlight = false;
+                if (!success) {
+                    LOGE("Error subiendo mip %u de %s en el worker", level, done.path.c_str());
+                    stats.residentBytes -= size;
+                    return;
+                }
+                commitLevel(done, level);
+            });
+    return true;
+}
+
+void TextureStreamer::commitLevel(StreamedTexture& texture, uint32_t level) {
+    // El cambio de nivel base se hace siempre en el hilo de render
+    glBindTexture(GL_TEXTURE_2D, texture.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level));
+    glBindTexture(GL_TEXTURE_2D, 0);
+    texture.residentBase = level;
+}
+
+bool TextureStreamer::evictLevel(StreamedTexture& texture) {
+    // El mip más pequeño nunca se expulsa: la textura debe seguir siendo muestreable
+    if (texture.residentBase + 1 >= texture.levelCount()) {
+        return false;
+    }
+
+    const uint32_t level = texture.residentBase;
+    const TextureLevel& mip = texture.levels[level];
+
+    glBindTexture(GL_TEXTURE_2D, texture.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level + 1));
+    // Redefinir el nivel con tamaño 0 libera su almacenamiento
+    glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), texture.internalFormat, 0, 0, 0, 0, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    texture.residentBase = level + 1;
+    stats.residentBytes -= mip.size;
+    stats.evictionsThisFrame++;
+    return true;
+}
+
+bool TextureStreamer::makeRoom(uint64_t bytes, const StreamedTexture* requester) {
+    while (stats.residentBytes + bytes > gpuBudgetBytes) {
+        // Víctima: la textura usada hace más tiempo que aún tenga mips altos residentes.
+        // Las usadas dentro de la ventana de streaming no cuentan: update() las volvería
+        // a subir en el frame siguiente.
+        StreamedTexture* victim = nullptr;
+        for (auto& texture : textures) {
+            if (&texture == requester || texture.uploadInFlight ||
+                texture.lastUsedFrame + kStreamingIdleFrames >= frameIndex ||
+                texture.residentBase + 1 >= texture.levelCount()) {
+                continue;
+            }
+            if (!victim || texture.lastUsedFrame < victim->lastUsedFrame ||
+                (texture.lastUsedFrame == victim->lastUsedFrame && texture.residentBase < victim->residentBase)) {
+                victim = &texture;
+            }
+        }
+
+        if (!victim || !evictLevel(*victim)) {
+            return false;
+        }
+    }
+    return true;
+}
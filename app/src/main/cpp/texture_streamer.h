@@ -0,0 +1,81 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <android/asset_manager.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "asset_file.h"
+
+struct GlStateCache;
+struct UploadWorker;
+
+using TextureHandle = int32_t;
+constexpr TextureHandle kInvalidTexture = -1;
+
+// Nivel de mip dentro del archivo KTX2 mapeado
+struct TextureLevel {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// Textura ASTC (contenedor KTX2) con mips residentes parcialmente.
+// Los niveles [residentBase, levelCount) están en GPU; GL_TEXTURE_BASE_LEVEL
+// se mantiene en residentBase para que la textura siempre sea completa.
+struct StreamedTexture {
+    std::string path;
+    GLuint texture = 0;
+    GLenum internalFormat = 0;
+    std::vector<TextureLevel> levels;   // 0 = mip más grande
+    uint32_t residentBase = 0;
+    uint32_t targetBase = 0;            // Nivel más grande deseado
+    uint64_t lastUsedFrame = 0;
+    bool uploadInFlight = false;        // Mip en subida en el hilo worker
+    std::unique_ptr<MappedAsset> file;  // Se mantiene mapeado para subir mips bajo demanda
+
+    uint32_t levelCount() const { return static_cast<uint32_t>(levels.size()); }
+};
+
+struct TextureStreamStats {
+    uint64_t residentBytes = 0;
+    uint64_t uploadedBytesThisFrame = 0;
+    uint32_t uploadsThisFrame = 0;
+    uint32_t evictionsThisFrame = 0;
+};
+
+// Subsistema de texturas: carga los mips pequeños al instante y sube los grandes
+// progresivamente con un presupuesto de bytes por frame. Si la memoria residente
+// supera el presupuesto de GPU, se expulsan los mips altos de las texturas
+// usadas hace más tiempo (LRU).
+struct TextureStreamer {
+    std::vector<StreamedTexture> textures;
+    uint64_t gpuBudgetBytes = 64ull * 1024 * 1024;
+    uint64_t uploadBudgetPerFrame = 2ull * 1024 * 1024;
+    uint64_t frameIndex = 0;
+    bool astcSupported = false;
+    TextureStreamStats stats;
+    UploadWorker* uploadWorker = nullptr;   // Opcional: sube los mips grandes fuera del hilo de render
+
+    bool initialize(uint64_t gpuBudget, uint64_t uploadBudget);
+    void cleanup();
+
+    TextureHandle load(AAssetManager* assetManager, const char* path);
+
+    // Marca la textura como usada en este frame; opcionalmente limita el mip más grande
+    void touch(TextureHandle handle, uint32_t maxResolutionLevel = 0);
+    void bind(GlStateCache& state, TextureHandle handle, GLuint unit) const;
+
+    // Sube mips pendientes dentro del presupuesto del frame
+    void update();
+
+private:
+    bool uploadLevel(StreamedTexture& texture, uint32_t level);
+    bool uploadLevelAsync(size_t textureIndex, uint32_t level);
+    void commitLevel(StreamedTexture& texture, uint32_t level);
+    bool evictLevel(StreamedTexture& texture);
+    bool makeRoom(uint64_t bytes, const StreamedTexture* requester);
+};
@@ -0,0 +1,240 @@
+#include "thread_registry.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "native_log.h"
+#include "xr_check.h"
+#include "xr_dispatch.h"
+
+namespace {
+
+struct RoleSpec {
+    const char* name;
+    XrAndroidThreadTypeKHR xrType;
+    int nice;            // Solo con pinning de host
+    bool bigCores;       // true: núcleos grandes; false: pequeños
+};
+
+// Valores de nice equivalentes a THREAD_PRIORITY_DISPLAY, BACKGROUND y DEFAULT de Android
+const RoleSpec kRoles[kThreadRoleCount] = {
+        {"render", XR_ANDROID_THREAD_TYPE_RENDERER_MAIN_KHR, -4, true},
+        {"simulación", XR_ANDROID_THREAD_TYPE_APPLICATION_MAIN_KHR, -4, true},
+        {"worker de render", XR_ANDROID_THREAD_TYPE_RENDERER_WORKER_KHR, 10, false},
+        {"worker", XR_ANDROID_THREAD_TYPE_APPLICATION_WORKER_KHR, 0, true},
+};
+
+constexpr uint32_t kMaxCores = 64;
+
+uint64_t readCoreMaxFrequency(uint32_t core) {
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq", core);
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    unsigned long long frequency = 0;
+    if (fscanf(file, "%llu", &frequency) != 1) {
+        frequency = 0;
+    }
+    fclose(file);
+    return frequency;
+}
+
+// Tiempo de CPU acumulado del hilo (primer campo de schedstat, en ns)
+uint64_t readThreadCpuNs(pid_t tid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/schedstat", static_cast<int>(tid));
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    unsigned long long runNs = 0;
+    if (fscanf(file, "%llu", &runNs) != 1) {
+        runNs = 0;
+    }
+    fclose(file);
+    return runNs;
+}
+
+uint64_t currentAffinityMask(pid_t tid) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(tid, sizeof(set), &set) != 0) {
+        return 0;
+    }
+    uint64_t mask = 0;
+    for (uint32_t core = 0; core < kMaxCores; core++) {
+        if (CPU_ISSET(core, &set)) {
+            mask |= 1ull << core;
+        }
+    }
+    return mask;
+}
+
+bool setAffinityMask(pid_t tid, uint64_t mask) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t core = 0; core < kMaxCores; core++) {
+        if (mask & (1ull << core)) {
+            CPU_SET(core, &set);
+        }
+    }
+    return sched_setaffinity(tid, sizeof(set), &set) == 0;
+}
+
+} // namespace
+
+CpuTopology queryCpuTopology() {
+    const long configured = sysconf(_SC_NPROCESSORS_CONF);
+    const uint32_t coreCount = static_cast<uint32_t>(std::min<long>(std::max<long>(configured, 1), kMaxCores));
+
+    uint64_t frequencies[kMaxCores] = {};
+    uint64_t minFrequency = UINT64_MAX;
+    uint64_t maxFrequency = 0;
+    for (uint32_t core = 0; core < coreCount; core++) {
+        frequencies[core] = readCoreMaxFrequency(core);
+        minFrequency = std::min(minFrequency, frequencies[core]);
+        maxFrequency = std::max(maxFrequency, frequencies[core]);
+    }
+
+    CpuTopology topology;
+    for (uint32_t core = 0; core < coreCount; core++) {
+        if (minFrequency == maxFrequency || frequencies[core] > minFrequency) {
+            topology.bigCores |= 1ull << core;
+        } else {
+            topology.littleCores |= 1ull << core;
+        }
+    }
+    return topology;
+}
+
+void ThreadRegistry::registerCurrentThread(ThreadRole role, const char* name) {
+    const pid_t tid = gettid();
+    // Nombre corto para systrace (máximo 15 caracteres)
+    char threadName[16];
+    snprintf(threadName, sizeof(threadName), "%s", name);
+    pthread_setname_np(pthread_self(), threadName);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Render y simulación son únicos: un hilo nuevo con ese papel sustituye al anterior
+    const bool uniqueRole = role == kThreadRoleRender || role == kThreadRoleSimulation;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&](const Entry& entry) { return entry.tid == tid || (uniqueRole && entry.role == role); }),
+                  entries.end());
+
+    Entry entry;
+    entry.tid = tid;
+    entry.role = role;
+    entry.name = name;
+    entry.lastCpuNs = readThreadCpuNs(tid);
+    registerWithRuntime(entry);
+    if (hostPinning) {
+        applyHostPolicy(entry);
+    }
+    entries.push_back(std::move(entry));
+    LOGI("Hilo registrado: %s (tid %d, %s)", name, static_cast<int>(tid), kRoles[role].name);
+}
+
+void ThreadRegistry::unregisterCurrentThread() {
+    const pid_t tid = gettid();
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [tid](const Entry& entry) { return entry.tid == tid; }),
+                  entries.end());
+}
+
+void ThreadRegistry::bindSession(const XrDispatch& dispatch, XrSession xrSession) {
+    std::lock_guard<std::mutex> lock(mutex);
+    setApplicationThread = dispatch.xrSetAndroidApplicationThreadKHR;
+    session = xrSession;
+    if (!setApplicationThread) {
+        LOGI("XR_KHR_android_thread_settings no disponible, el runtime no conoce los hilos críticos");
+        return;
+    }
+    for (Entry& entry : entries) {
+        entry.runtimeRegistered = false;
+        registerWithRuntime(entry);
+    }
+}
+
+void ThreadRegistry::unbindSession() {
+    std::lock_guard<std::mutex> lock(mutex);
+    setApplicationThread = nullptr;
+    session = XR_NULL_HANDLE;
+    for (Entry& entry : entries) {
+        entry.runtimeRegistered = false;
+    }
+}
+
+void ThreadRegistry::setHostPinning(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (hostPinning == enabled) {
+        return;
+    }
+    hostPinning = enabled;
+    if (enabled && !topologyQueried) {
+        topology = queryCpuTopology();
+        topologyQueried = true;
+        LOGI("Núcleos grandes 0x%llX, pequeños 0x%llX", static_cast<unsigned long long>(topology.bigCores),
+             static_cast<unsigned long long>(topology.littleCores));
+    }
+    for (const Entry& entry : entries) {
+        applyHostPolicy(entry);
+    }
+    LOGI("Pinning de hilos en el host %s", enabled ? "activado" : "desactivado");
+}
+
+void ThreadRegistry::logStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    LOGI("Hilos registrados (%zu):", entries.size());
+    for (Entry& entry : entries) {
+        const uint64_t cpuNs = readThreadCpuNs(entry.tid);
+        const double cpuMs = cpuNs >= entry.lastCpuNs ? static_cast<double>(cpuNs - entry.lastCpuNs) / 1e6 : 0.0;
+        entry.lastCpuNs = cpuNs;
+        errno = 0;
+        const int nice = getpriority(PRIO_PROCESS, static_cast<id_t>(entry.tid));
+        LOGI("  %s (tid %d): %s, runtime %s, nice %d, CPUs 0x%llX, %.1f ms de CPU",
+             entry.name.c_str(), static_cast<int>(entry.tid), kRoles[entry.role].name,
+             entry.runtimeRegistered ? "sí" : "no", errno == 0 ? nice : 0,
+             static_cast<unsigned long long>(currentAffinityMask(entry.tid)), cpuMs);
+    }
+}
+
+void ThreadRegistry::registerWithRuntime(Entry& entry) {
+    if (!setApplicationThread || session == XR_NULL_HANDLE || entry.runtimeRegistered) {
+        return;
+    }
+    entry.runtimeRegistered = CheckXrResult(
+            setApplicationThread(session, kRoles[entry.role].xrType, static_cast<uint32_t>(entry.tid)),
+            "xrSetAndroidApplicationThreadKHR");
+    if (entry.runtimeRegistered) {
+        LOGI("✓ Hilo %s (tid %d) comunicado al runtime como %s",
+             entry.name.c_str(), static_cast<int>(entry.tid), kRoles[entry.role].name);
+    }
+}
+
+void ThreadRegistry::applyHostPolicy(const Entry& entry) {
+    const RoleSpec& spec = kRoles[entry.role];
+    uint64_t mask = topology.bigCores | topology.littleCores;
+    int nice = 0;
+    if (hostPinning) {
+        mask = (spec.bigCores || topology.littleCores == 0) ? topology.bigCores : topology.littleCores;
+        nice = spec.nice;
+    }
+
+    if (mask != 0 && !setAffinityMask(entry.tid, mask)) {
+        LOGE("No se pudo fijar la afinidad de %s (tid %d): %s", entry.name.c_str(),
+             static_cast<int>(entry.tid), strerror(errno));
+    }
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(entry.tid), nice) != 0) {
+        LOGE("No se pudo fijar nice %d en %s (tid %d): %s", nice, entry.name.c_str(),
+             static_cast<int>(entry.tid), strerror(errno));
+    }
+}
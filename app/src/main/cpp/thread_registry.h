@@ -0,0 +1,76 @@
+#pragma once
+
+#include <jni.h>
+#include <EGL/egl.h>
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+#include <sys/types.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct XrDispatch;
+
+// Núcleos del host agrupados por clúster. Los grandes son los de frecuencia
+// máxima superior a la del clúster más lento; sin cpufreq todos son grandes.
+struct CpuTopology {
+    uint64_t bigCores = 0;
+    uint64_t littleCores = 0;
+
+    uint32_t bigCount() const { return static_cast<uint32_t>(__builtin_popcountll(bigCores)); }
+    uint32_t coreCount() const { return static_cast<uint32_t>(__builtin_popcountll(bigCores | littleCores)); }
+};
+CpuTopology queryCpuTopology();
+
+// Papel de cada hilo de la app. Render y simulación son únicos; los workers
+// pueden ser varios. Hoy la simulación corre dentro de nativeRunFrame en el
+// hilo de render, así que ese hilo solo se registra como render.
+enum ThreadRole : uint32_t {
+    kThreadRoleRender = 0,        // XR_ANDROID_THREAD_TYPE_RENDERER_MAIN_KHR
+    kThreadRoleSimulation,        // XR_ANDROID_THREAD_TYPE_APPLICATION_MAIN_KHR
+    kThreadRoleRenderWorker,      // XR_ANDROID_THREAD_TYPE_RENDERER_WORKER_KHR
+    kThreadRoleWorker,            // XR_ANDROID_THREAD_TYPE_APPLICATION_WORKER_KHR (job system)
+    kThreadRoleCount
+};
+
+// Registro de hilos: informa al runtime de los hilos críticos para latencia
+// (XR_KHR_android_thread_settings) y, en modo benchmark, fija afinidad y nice
+// en el host. Es seguro llamarlo desde cualquier hilo.
+struct ThreadRegistry {
+    // Registra el hilo actual y le pone nombre (visible en systrace/perfetto)
+    void registerCurrentThread(ThreadRole role, const char* name);
+    void unregisterCurrentThread();
+
+    // Con sesión, los hilos registrados (y los que lleguen) se comunican al runtime
+    void bindSession(const XrDispatch& dispatch, XrSession session);
+    void unbindSession();
+
+    // Benchmarks: render, simulación y workers del frame en los núcleos grandes
+    // (render y simulación con prioridad de display); los workers de render, que
+    // hacen trabajo de fondo, en los pequeños. Al desactivarlo se restauran los valores.
+    void setHostPinning(bool enabled);
+
+    // Papel, tid, registro en el runtime, nice, afinidad y CPU desde el último log
+    void logStats();
+
+private:
+    struct Entry {
+        pid_t tid = 0;
+        ThreadRole role = kThreadRoleWorker;
+        std::string name;
+        bool runtimeRegistered = false;
+        uint64_t lastCpuNs = 0;
+    };
+
+    void registerWithRuntime(Entry& entry);
+    void applyHostPolicy(const Entry& entry);
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+    PFN_xrSetAndroidApplicationThreadKHR setApplicationThread = nullptr;
+    XrSession session = XR_NULL_HANDLE;
+    bool hostPinning = false;
+    bool topologyQueried = false;
+    CpuTopology topology;
+};
@@ -0,0 +1,219 @@
+#include "uniform_ring.h"
+
+#include <EGL/egl.h>
+#include <GLES2/gl2ext.h>
+#include <cstring>
+
+#include "gl_state_cache.h"
+#include "native_log.h"
+
+namespace {
+
+// Timeout de cada espera de fence (el slot debería estar libre casi siempre)
+constexpr GLuint64 kFenceWaitTimeoutNs = 100000000; // 100 ms
+
+GLintptr alignUp(GLintptr value, GLintptr alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool hasGlExtension(const char* name) {
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    return extensions && strstr(extensions, name) != nullptr;
+}
+
+} // namespace
+
+bool UniformRing::initialize(uint32_t frameSlots, GLsizeiptr bytesPerSlot) {
+    destroy();
+
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    if (offsetAlignment <= 0) {
+        offsetAlignment = 256;
+    }
+
+    slotCount = frameSlots;
+    slotSize = alignUp(bytesPerSlot, offsetAlignment);
+    const GLsizeiptr totalSize = slotSize * slotCount;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+
+    // Preferimos almacenamiento inmutable mapeado de forma persistente
+    PFNGLBUFFERSTORAGEEXTPROC pfnBufferStorage = nullptr;
+    if (hasGlExtension("GL_EXT_buffer_storage")) {
+        pfnBufferStorage = reinterpret_cast<PFNGLBUFFERSTORAGEEXTPROC>(eglGetProcAddress("glBufferStorageEXT"));
+    }
+
+    if (pfnBufferStorage) {
+        pfnBufferStorage(GL_UNIFORM_BUFFER, totalSize, nullptr,
+                         GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT);
+        mapped = static_cast<uint8_t*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, totalSize,
+                                                        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT |
+                                                        GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT));
+        persistent = mapped != nullptr;
+        if (!persistent) {
+            LOGE("Mapeo persistente del anillo UBO falló (0x%x), usando mapeo por frame", glGetError());
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+        }
+    }
+
+    if (!persistent) {
+        glBufferData(GL_UNIFORM_BUFFER, totalSize, nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    GLenum glError = glGetError();
+    if (glError != GL_NO_ERROR) {
+        LOGE("Error creando anillo UBO: 0x%x", glError);
+        destroy();
+        return false;
+    }
+
+    fences.assign(slotCount, nullptr);
+    currentSlot = slotCount - 1; // beginFrame() avanza al slot 0
+
+    LOGI("✓ Anillo UBO creado: %u slots x %ld bytes (alineación %d, %s)",
+         slotCount, static_cast<long>(slotSize), offsetAlignment,
+         persistent ? "mapeo persistente" : "mapeo por frame");
+    return true;
+}
+
+void UniformRing::destroy() {
+    for (auto& fence : fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    fences.clear();
+
+    if (buffer != 0) {
+        if (mapped) {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+
+    mapped = nullptr;
+    persistent = false;
+    slotCount = 0;
+    slotSize = 0;
+    slotCursor = flushedCursor = 0;
+    frameOpen = false;
+}
+
+bool UniformRing::beginFrame() {
+    if (buffer == 0) {
+        return false;
+    }
+    if (frameOpen) {
+        // Un frame anterior terminó por una ruta de error; cerrarlo antes de reutilizar
+        endFrame();
+    }
+
+    currentSlot = (currentSlot + 1) % slotCount;
+    slotCursor = 0;
+    flushedCursor = 0;
+
+    // Esperar a que la GPU termine de leer este slot
+    GLsync& fence = fences[currentSlot];
+    if (fence) {
+        GLenum waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kFenceWaitTimeoutNs);
+        while (waitResult == GL_TIMEOUT_EXPIRED) {
+            LOGD("Anillo UBO: esperando fence del slot %u", currentSlot);
+            waitResult = glClientWaitSync(fence, 0, kFenceWaitTimeoutNs);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+        if (waitResult == GL_WAIT_FAILED) {
+            LOGE("glClientWaitSync falló en el anillo UBO: 0x%x", glGetError());
+            return false;
+        }
+    }
+
+    if (!persistent) {
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+        mapped = static_cast<uint8_t*>(glMapBufferRange(GL_UNIFORM_BUFFER, currentSlot * slotSize, slotSize,
+                                                        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+                                                        GL_MAP_FLUSH_EXPLICIT_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        if (!mapped) {
+            LOGE("glMapBufferRange del slot %u falló: 0x%x", currentSlot, glGetError());
+            return false;
+        }
+    }
+
+    frameOpen = true;
+    return true;
+}
+
+UniformAllocation UniformRing::allocate(GLsizeiptr size) {
+    UniformAllocation allocation;
+    if (!frameOpen || !mapped) {
+        return allocation;
+    }
+
+    GLintptr offset = alignUp(slotCursor, offsetAlignment);
+    if (offset + size > slotSize) {
+        LOGE("Anillo UBO sin espacio: %ld + %ld > %ld bytes",
+             static_cast<long>(offset), static_cast<long>(size), static_cast<long>(slotSize));
+        return allocation;
+    }
+    slotCursor = offset + size;
+
+    // En modo persistente el mapeo cubre todo el buffer; en fallback solo el slot
+    const GLintptr slotBase = currentSlot * slotSize;
+    allocation.offset = slotBase + offset;
+    allocation.size = size;
+    allocation.data = persistent ? mapped + slotBase + offset : mapped + offset;
+    return allocation;
+}
+
+void UniformRing::flush() {
+    if (!frameOpen || slotCursor == flushedCursor) {
+        if (frameOpen && !persistent && mapped) {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            mapped = nullptr;
+        }
+        return;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    if (persistent) {
+        glFlushMappedBufferRange(GL_UNIFORM_BUFFER, currentSlot * slotSize + flushedCursor,
+                                 slotCursor - flushedCursor);
+    } else if (mapped) {
+        // El rango de flush es relativo al mapeo del slot; la GPU no puede leer
+        // un buffer mapeado sin almacenamiento persistente, así que se desmapea aquí
+        glFlushMappedBufferRange(GL_UNIFORM_BUFFER, flushedCursor, slotCursor - flushedCursor);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        mapped = nullptr;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    flushedCursor = slotCursor;
+}
+
+void UniformRing::endFrame() {
+    if (!frameOpen) {
+        return;
+    }
+    flush();
+
+    GLsync& fence = fences[currentSlot];
+    if (fence) {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frameOpen = false;
+}
+
+void UniformRing::bind(GlStateCache& state, GLuint bindingPoint, const UniformAllocation& allocation) const {
+    state.bindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, buffer, allocation.offset, allocation.size);
+}
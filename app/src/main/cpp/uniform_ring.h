@@ -0,0 +1,68 @@
+#pragma once
+
+#include <GLES3/gl3.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "xr_math.h"
+
+struct GlStateCache;
+
+// Puntos de binding de los bloques uniformes (compartidos con los shaders)
+constexpr GLuint kViewUniformBinding = 0;
+constexpr GLuint kDrawUniformBinding = 1;
+
+// Bloque std140 "ViewData": datos por vista (uno por ojo y frame)
+struct ViewUniforms {
+    Mat4 viewProj;
+};
+
+// Bloque std140 "DrawData": datos por draw
+struct DrawUniforms {
+    Mat4 model;
+    float color[4];
+};
+
+// Región reservada dentro del slot del frame actual
+struct UniformAllocation {
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+    void* data = nullptr;
+};
+
+// Anillo de UBOs: un único buffer dividido en un slot por frame en vuelo.
+// Con GL_EXT_buffer_storage se mapea una sola vez (persistente, flush explícito);
+// sin él se mapea el slot por frame con GL_MAP_UNSYNCHRONIZED_BIT. En ambos casos
+// un glFenceSync por slot evita escribir memoria que la GPU todavía está leyendo.
+struct UniformRing {
+    GLuint buffer = 0;
+    uint8_t* mapped = nullptr;       // Base del mapeo (persistente) o del slot actual (fallback)
+    bool persistent = false;
+    uint32_t slotCount = 0;
+    GLsizeiptr slotSize = 0;
+    GLint offsetAlignment = 256;
+
+    uint32_t currentSlot = 0;
+    GLintptr slotCursor = 0;         // Bytes usados en el slot actual
+    GLintptr flushedCursor = 0;      // Bytes ya enviados con glFlushMappedBufferRange
+    bool frameOpen = false;
+    std::vector<GLsync> fences;
+
+    bool initialize(uint32_t frameSlots, GLsizeiptr bytesPerSlot);
+    void destroy();
+
+    // Espera el fence del siguiente slot y lo deja listo para escribir
+    bool beginFrame();
+
+    // Reserva memoria alineada; el llamador escribe con memcpy sobre data
+    UniformAllocation allocate(GLsizeiptr size);
+
+    // Hace visibles a la GPU las escrituras pendientes (debe llamarse antes de los draws)
+    void flush();
+
+    // Coloca el fence del slot y avanza el anillo
+    void endFrame();
+
+    void bind(GlStateCache& state, GLuint bindingPoint, const UniformAllocation& allocation) const;
+};
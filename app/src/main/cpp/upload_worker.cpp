@@ -0,0 +1,207 @@
+#include "upload_worker.h"
+
+#include <EGL/eglext.h>
+#include <cstring>
+
+#include "native_log.h"
+#include "thread_registry.h"
+
+bool UploadWorker::start(EGLDisplay eglDisplay, EGLConfig eglConfig, EGLContext shareContext) {
+    if (running) {
+        return true;
+    }
+    if (eglDisplay == EGL_NO_DISPLAY || shareContext == EGL_NO_CONTEXT) {
+        LOGE("UploadWorker: no hay contexto EGL para compartir");
+        return false;
+    }
+
+    display = eglDisplay;
+    stopRequested = false;
+    startupDone = false;
+
+    // El contexto se crea en el propio hilo; esperamos a saber si funcionó
+    thread = std::thread(&UploadWorker::threadMain, this, eglConfig, shareContext);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    startedSignal.wait(lock, [this] { return startupDone; });
+    if (!running) {
+        lock.unlock();
+        thread.join();
+        return false;
+    }
+
+    LOGI("✓ Hilo de subida GL iniciado (contexto compartido %p)", context);
+    return true;
+}
+
+void UploadWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!thread.joinable()) {
+            return;
+        }
+        stopRequested = true;
+    }
+    wakeUp.notify_one();
+    // El hilo libera los fences pendientes con su contexto antes de salir: aquí puede
+    // no haber contexto activo o estarlo uno fuera del share group
+    thread.join();
+
+    pending.clear();
+    running = false;
+    LOGI("Hilo de subida GL detenido");
+}
+
+void UploadWorker::submit(UploadJob job, UploadCompletion onComplete) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back({std::move(job), std::move(onComplete)});
+    }
+    wakeUp.notify_one();
+}
+
+uint32_t UploadWorker::pollCompleted() {
+    uint32_t completed = 0;
+    while (true) {
+        FinishedJob job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (finished.empty()) {
+                break;
+            }
+            // Timeout 0: nunca bloquea el hilo de render
+            GLenum status = glClientWaitSync(finished.front().fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            job = std::move(finished.front());
+            finished.pop_front();
+            if (status == GL_WAIT_FAILED) {
+                LOGE("UploadWorker: glClientWaitSync falló: 0x%x", glGetError());
+                job.success = false;
+            }
+        }
+
+        glDeleteSync(job.fence);
+        if (job.onComplete) {
+            job.onComplete(job.success);
+        }
+        completed++;
+    }
+    return completed;
+}
+
+bool UploadWorker::createContext(EGLConfig eglConfig, EGLContext shareContext) {
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    const bool surfaceless = extensions && strstr(extensions, "EGL_KHR_surfaceless_context");
+
+    EGLConfig contextConfig = eglConfig;
+    if (!surfaceless) {
+        // Sin surfaceless_context hace falta un pbuffer, y una config que lo admita
+        const EGLint pbufferConfigAttribs[] = {
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT_KHR,
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+                EGL_NONE
+        };
+        EGLint numConfigs = 0;
+        if (!eglChooseConfig(display, pbufferConfigAttribs, &contextConfig, 1, &numConfigs) || numConfigs == 0) {
+            LOGE("UploadWorker: no hay config EGL con pbuffer: 0x%X", eglGetError());
+            return false;
+        }
+
+        const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        surface = eglCreatePbufferSurface(display, contextConfig, pbufferAttribs);
+        if (surface == EGL_NO_SURFACE) {
+            LOGE("UploadWorker: eglCreatePbufferSurface falló: 0x%X", eglGetError());
+            return false;
+        }
+    }
+
+    const EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+    context = eglCreateContext(display, contextConfig, shareContext, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        LOGE("UploadWorker: eglCreateContext compartido falló: 0x%X", eglGetError());
+        destroyContext();
+        return false;
+    }
+
+    if (!eglMakeCurrent(display, surface, surface, context)) {
+        LOGE("UploadWorker: eglMakeCurrent falló: 0x%X", eglGetError());
+        destroyContext();
+        return false;
+    }
+
+    LOGI("UploadWorker: contexto %s", surfaceless ? "surfaceless" : "con pbuffer 1x1");
+    return true;
+}
+
+void UploadWorker::destroyContext() {
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context != EGL_NO_CONTEXT) {
+        eglDestroyContext(display, context);
+        context = EGL_NO_CONTEXT;
+    }
+    if (surface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, surface);
+        surface = EGL_NO_SURFACE;
+    }
+}
+
+void UploadWorker::threadMain(EGLConfig eglConfig, EGLContext shareContext) {
+    if (threadRegistry) {
+        threadRegistry->registerCurrentThread(kThreadRoleRenderWorker, "xr_upload");
+    }
+    bool contextReady = createContext(eglConfig, shareContext);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = contextReady;
+        startupDone = true;
+    }
+    startedSignal.notify_one();
+    if (!contextReady) {
+        if (threadRegistry) {
+            threadRegistry->unregisterCurrentThread();
+        }
+        return;
+    }
+
+    while (true) {
+        PendingJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stopRequested || !pending.empty(); });
+            if (stopRequested) {
+                break;
+            }
+            job = std::move(pending.front());
+            pending.pop_front();
+        }
+
+        bool success = job.job ? job.job() : true;
+
+        // El fence publica el recurso: el render no lo usa hasta verlo señalizado
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back({fence, success, std::move(job.onComplete)});
+    }
+
+    // Trabajos terminados que nadie recogerá: liberar sus fences sin ejecutar las completions
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& job : finished) {
+            if (job.fence) {
+                glDeleteSync(job.fence);
+            }
+        }
+        finished.clear();
+    }
+
+    glFinish();
+    destroyContext();
+    if (threadRegistry) {
+        threadRegistry->unregisterCurrentThread();
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+struct ThreadRegistry;
+
+// Trabajo de subida: se ejecuta en el hilo worker con su contexto compartido activo
+using UploadJob = std::function<bool()>;
+// Se ejecuta en el hilo de render cuando el fence del trabajo ya está señalizado
+using UploadCompletion = std::function<void(bool success)>;
+
+// Hilo de subida de recursos GL con su propio contexto EGL en el share group
+// del contexto de render. Buffers y texturas creados aquí son visibles desde el
+// render; los objetos contenedor (VAO, FBO) no se comparten y deben crearse allí.
+struct UploadWorker {
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+    EGLSurface surface = EGL_NO_SURFACE;   // Pbuffer 1x1 si no hay surfaceless_context
+    ThreadRegistry* threadRegistry = nullptr;   // Opcional: registra el hilo como worker de render
+
+    bool start(EGLDisplay eglDisplay, EGLConfig eglConfig, EGLContext shareContext);
+    void stop();
+    bool isRunning() const { return running; }
+
+    void submit(UploadJob job, UploadCompletion onComplete);
+
+    // Hilo de render: consulta los fences sin bloquear y ejecuta las completions listas
+    uint32_t pollCompleted();
+
+private:
+    struct PendingJob {
+        UploadJob job;
+        UploadCompletion onComplete;
+    };
+    struct FinishedJob {
+        GLsync fence = nullptr;
+        bool success = false;
+        UploadCompletion onComplete;
+    };
+
+    bool createContext(EGLConfig eglConfig, EGLContext shareContext);
+    void destroyContext();
+    void threadMain(EGLConfig eglConfig, EGLContext shareContext);
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable startedSignal;
+    std::deque<PendingJob> pending;
+    std::deque<FinishedJob> finished;
+    bool running = false;
+    bool stopRequested = false;
+    bool startupDone = false;
+};
@@ -0,0 +1,114 @@
+#include "xr_capabilities.h"
+
+#include <jni.h>
+#include <EGL/egl.h>
+#include <openxr/openxr_platform.h>
+
+#include "native_log.h"
+#include "xr_check.h"
+
+namespace {
+
+// Sin estas la app no puede arrancar
+const char* const kRequiredExtensions[] = {
+        XR_KHR_ANDROID_CREATE_INSTANCE_EXTENSION_NAME,
+        XR_KHR_OPENGL_ES_ENABLE_EXTENSION_NAME,
+};
+
+constexpr uint32_t kMaxFeatureExtensions = 3;
+
+struct FeatureSpec {
+    XrFeature feature;
+    const char* label;
+    const char* extensions[kMaxFeatureExtensions];
+    XrFeature dependsOn;   // kFeatureCount si no depende de otra
+};
+
+// En orden: una funcionalidad solo puede depender de otra anterior
+const FeatureSpec kOptionalFeatures[] = {
+        {kFeatureLocateSpaces, "localización de espacios en lote",
+                {XR_KHR_LOCATE_SPACES_EXTENSION_NAME}, kFeatureCount},
+        {kFeatureConvertTimespec, "conversión timespec",
+                {XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME}, kFeatureCount},
+        {kFeatureHandTracking, "hand tracking",
+                {XR_EXT_HAND_TRACKING_EXTENSION_NAME}, kFeatureCount},
+        {kFeatureFoveation, "foveation",
+                {XR_FB_FOVEATION_EXTENSION_NAME, XR_FB_FOVEATION_CONFIGURATION_EXTENSION_NAME,
+                 XR_FB_SWAPCHAIN_UPDATE_STATE_EXTENSION_NAME}, kFeatureCount},
+        {kFeatureEyeTrackedFoveation, "foveation eye-tracked",
+                {XR_META_FOVEATION_EYE_TRACKED_EXTENSION_NAME}, kFeatureFoveation},
+        {kFeaturePassthrough, "passthrough",
+                {XR_FB_PASSTHROUGH_EXTENSION_NAME}, kFeatureCount},
+        {kFeatureAlphaBlend, "alpha blend de capas",
+                {XR_FB_COMPOSITION_LAYER_ALPHA_BLEND_EXTENSION_NAME}, kFeatureCount},
+        {kFeatureColorSpace, "espacio de color",
+                {XR_FB_COLOR_SPACE_EXTENSION_NAME}, kFeatureCount},
+        {kFeatureThreadSettings, "hilos críticos para el runtime",
+                {XR_KHR_ANDROID_THREAD_SETTINGS_EXTENSION_NAME}, kFeatureCount},
+};
+
+} // namespace
+
+bool XrCapabilities::resolve() {
+    reset();
+
+    uint32_t extensionCount = 0;
+    if (!CheckXrResult(xrEnumerateInstanceExtensionProperties(nullptr, 0, &extensionCount, nullptr),
+                       "xrEnumerateInstanceExtensionProperties (count)")) {
+        return false;
+    }
+
+    std::vector<XrExtensionProperties> properties(extensionCount, {XR_TYPE_EXTENSION_PROPERTIES});
+    if (!CheckXrResult(xrEnumerateInstanceExtensionProperties(nullptr, extensionCount, &extensionCount, properties.data()),
+                       "xrEnumerateInstanceExtensionProperties (data)")) {
+        return false;
+    }
+
+    availableVersions.reserve(extensionCount);
+    for (uint32_t i = 0; i < extensionCount; i++) {
+        availableVersions.emplace(properties[i].extensionName, properties[i].extensionVersion);
+    }
+    LOGI("Encontradas %u extensiones disponibles", extensionCount);
+
+    for (const char* name : kRequiredExtensions) {
+        if (!isAvailable(name)) {
+            LOGE("✗ Extensión requerida %s no disponible", name);
+            return false;
+        }
+        extensions.push_back(name);
+        LOGI("✓ Extensión requerida %s", name);
+    }
+
+    for (const FeatureSpec& spec : kOptionalFeatures) {
+        if (spec.dependsOn != kFeatureCount && !has(spec.dependsOn)) {
+            continue;
+        }
+        bool supported = true;
+        for (const char* name : spec.extensions) {
+            if (name && !isAvailable(name)) {
+                supported = false;
+                break;
+            }
+        }
+        if (!supported) {
+            LOGI("Funcionalidad opcional no disponible: %s", spec.label);
+            continue;
+        }
+        for (const char* name : spec.extensions) {
+            if (name) {
+                extensions.push_back(name);
+            }
+        }
+        features |= 1u << spec.feature;
+        LOGI("✓ Funcionalidad opcional habilitada: %s", spec.label);
+    }
+
+    LOGI("✓ %zu extensiones a habilitar, funcionalidades 0x%02X", extensions.size(), features);
+    return true;
+}
+
+void XrCapabilities::reset() {
+    availableVersions.clear();
+    extensions.clear();
+    features = 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Funcionalidades opcionales que el motor puede usar. Cada una se habilita solo
+// si el runtime ofrece todas sus extensiones (y la funcionalidad de la que depende).
+enum XrFeature : uint32_t {
+    kFeatureLocateSpaces = 0,         // XR_KHR_locate_spaces
+    kFeatureConvertTimespec,          // XR_KHR_convert_timespec_time
+    kFeatureHandTracking,             // XR_EXT_hand_tracking
+    kFeatureFoveation,                // XR_FB_foveation + configuration + swapchain_update_state
+    kFeatureEyeTrackedFoveation,      // XR_META_foveation_eye_tracked (requiere kFeatureFoveation)
+    kFeaturePassthrough,              // XR_FB_passthrough
+    kFeatureAlphaBlend,               // XR_FB_composition_layer_alpha_blend
+    kFeatureColorSpace,               // XR_FB_color_space
+    kFeatureThreadSettings,           // XR_KHR_android_thread_settings
+    kFeatureCount
+};
+
+using XrFeatureSet = uint32_t;
+static_assert(kFeatureCount <= 32, "XrFeatureSet no tiene bits suficientes");
+
+// Registro de capacidades: extensiones disponibles en un conjunto con hash,
+// extensiones requeridas y opcionales declaradas en una tabla, y el resultado
+// como lista de extensiones a habilitar más un bitset de funcionalidades.
+struct XrCapabilities {
+    // Consulta el runtime; false si falta alguna extensión requerida
+    bool resolve();
+    void reset();
+
+    bool isAvailable(const char* name) const { return availableVersions.count(name) != 0; }
+    bool has(XrFeature feature) const { return (features & (1u << feature)) != 0; }
+
+    // Nombres para XrInstanceCreateInfo (apuntan a literales estáticos)
+    const std::vector<const char*>& enabledExtensions() const { return extensions; }
+    XrFeatureSet enabledFeatures() const { return features; }
+
+private:
+    std::unordered_map<std::string, uint32_t> availableVersions;   // nombre -> specVersion
+    std::vector<const char*> extensions;
+    XrFeatureSet features = 0;
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <openxr/openxr.h>
+
+// Registra el error (con detalle para los casos comunes) y devuelve false si result falló.
+// Definida en native_openxr.cpp.
+bool CheckXrResult(XrResult result, const char* operation);
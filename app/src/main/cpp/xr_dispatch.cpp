@@ -0,0 +1,24 @@
+#include "xr_dispatch.h"
+
+#include "native_log.h"
+
+uint32_t XrDispatch::load(XrInstance instance) {
+    uint32_t resolved = 0;
+    uint32_t total = 0;
+
+    // Sin log por función: faltar es lo normal si la extensión no se habilitó
+#define XR_DISPATCH_LOAD(name, extension)                                                  \
+    total++;                                                                               \
+    if (XR_SUCCEEDED(xrGetInstanceProcAddr(instance, "xr" #name,                           \
+                                           reinterpret_cast<PFN_xrVoidFunction*>(&xr##name))) && \
+        xr##name) {                                                                        \
+        resolved++;                                                                        \
+    } else {                                                                               \
+        xr##name = nullptr;                                                                \
+    }
+    XR_DISPATCH_FUNCTIONS(XR_DISPATCH_LOAD)
+#undef XR_DISPATCH_LOAD
+
+    LOGI("✓ Tabla de funciones de extensión: %u de %u resueltas", resolved, total);
+    return resolved;
+}
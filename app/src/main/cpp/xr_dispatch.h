@@ -0,0 +1,41 @@
+#pragma once
+
+#include <jni.h>
+#include <EGL/egl.h>
+#include <time.h>
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+#include <openxr/openxr_reflection.h>
+#include <cstdint>
+
+// XR_KHR_locate_spaces se promovió a core en 1.1 y openxr_reflection.h ya no
+// lista su función con sufijo KHR; se declara aquí con la misma forma
+#define XR_DISPATCH_FUNCTIONS_XR_KHR_locate_spaces(_) \
+    _(LocateSpacesKHR, KHR_locate_spaces)
+
+// Funciones de extensión que usa la app. Para añadir una extensión basta con
+// añadir su lista XR_LIST_FUNCTIONS_<extensión> de openxr_reflection.h.
+#define XR_DISPATCH_FUNCTIONS(_) \
+    XR_LIST_FUNCTIONS_XR_KHR_opengl_es_enable(_) \
+    XR_DISPATCH_FUNCTIONS_XR_KHR_locate_spaces(_) \
+    XR_LIST_FUNCTIONS_XR_KHR_convert_timespec_time(_) \
+    XR_LIST_FUNCTIONS_XR_EXT_hand_tracking(_) \
+    XR_LIST_FUNCTIONS_XR_FB_foveation(_) \
+    XR_LIST_FUNCTIONS_XR_FB_swapchain_update_state(_) \
+    XR_LIST_FUNCTIONS_XR_META_foveation_eye_tracked(_) \
+    XR_LIST_FUNCTIONS_XR_FB_passthrough(_) \
+    XR_LIST_FUNCTIONS_XR_FB_color_space(_) \
+    XR_LIST_FUNCTIONS_XR_KHR_android_thread_settings(_)
+
+// Tabla de funciones de extensión resuelta una sola vez tras xrCreateInstance.
+// Las funciones de extensiones no habilitadas quedan a nullptr, así que
+// comprobar una extensión es comprobar su puntero.
+struct XrDispatch {
+#define XR_DISPATCH_MEMBER(name, extension) PFN_xr##name xr##name = nullptr;
+    XR_DISPATCH_FUNCTIONS(XR_DISPATCH_MEMBER)
+#undef XR_DISPATCH_MEMBER
+
+    // Devuelve cuántas funciones se resolvieron
+    uint32_t load(XrInstance instance);
+    void clear() { *this = XrDispatch{}; }
+};
@@ -0,0 +1,266 @@
+#include "xr_input.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "native_log.h"
+#include "xr_check.h"
+
+namespace {
+
+// Umbral para convertir trigger/grip analógicos en botones digitales
+constexpr float kAnalogButtonThreshold = 0.5f;
+
+bool createAction(XrActionSet actionSet, const XrPath* handPaths, XrActionType type,
+                  const char* name, const char* localizedName, XrAction* action) {
+    XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
+    actionInfo.actionType = type;
+    strncpy(actionInfo.actionName, name, XR_MAX_ACTION_NAME_SIZE - 1);
+    strncpy(actionInfo.localizedActionName, localizedName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE - 1);
+    actionInfo.countSubactionPaths = kHandCount;
+    actionInfo.subactionPaths = handPaths;
+    return CheckXrResult(xrCreateAction(actionSet, &actionInfo, action), name);
+}
+
+struct BindingList {
+    XrInstance instance;
+    std::vector<XrActionSuggestedBinding> bindings;
+
+    void add(XrAction action, const char* path) {
+        XrPath binding = XR_NULL_PATH;
+        if (XR_SUCCEEDED(xrStringToPath(instance, path, &binding))) {
+            bindings.push_back({action, binding});
+        }
+    }
+
+    bool suggest(const char* interactionProfile) {
+        XrPath profilePath = XR_NULL_PATH;
+        if (!CheckXrResult(xrStringToPath(instance, interactionProfile, &profilePath), "xrStringToPath (perfil)")) {
+            return false;
+        }
+        XrInteractionProfileSuggestedBinding suggested{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+        suggested.interactionProfile = profilePath;
+        suggested.countSuggestedBindings = static_cast<uint32_t>(bindings.size());
+        suggested.suggestedBindings = bindings.data();
+        XrResult result = xrSuggestInteractionProfileBindings(instance, &suggested);
+        if (XR_FAILED(result)) {
+            LOGE("Bindings para %s rechazados: %d", interactionProfile, result);
+            return false;
+        }
+        LOGI("✓ Bindings sugeridos para %s (%zu)", interactionProfile, bindings.size());
+        return true;
+    }
+};
+
+float readFloat(XrSession session, XrAction action, XrPath subaction, bool& active) {
+    XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+    getInfo.action = action;
+    getInfo.subactionPath = subaction;
+    XrActionStateFloat state{XR_TYPE_ACTION_STATE_FLOAT};
+    if (XR_FAILED(xrGetActionStateFloat(session, &getInfo, &state)) || !state.isActive) {
+        return 0.0f;
+    }
+    active = true;
+    return state.currentState;
+}
+
+bool readBoolean(XrSession session, XrAction action, XrPath subaction) {
+    XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+    getInfo.action = action;
+    getInfo.subactionPath = subaction;
+    XrActionStateBoolean state{XR_TYPE_ACTION_STATE_BOOLEAN};
+    if (XR_FAILED(xrGetActionStateBoolean(session, &getInfo, &state)) || !state.isActive) {
+        return false;
+    }
+    return state.currentState == XR_TRUE;
+}
+
+} // namespace
+
+bool XrInput::initializeInstance(XrInstance instance) {
+    if (actionSet != XR_NULL_HANDLE) {
+        return true;
+    }
+    LOGI("Creando sistema de acciones de input...");
+
+    XrActionSetCreateInfo actionSetInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+    strncpy(actionSetInfo.actionSetName, "gameplay", XR_MAX_ACTION_SET_NAME_SIZE - 1);
+    strncpy(actionSetInfo.localizedActionSetName, "Gameplay", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE - 1);
+    actionSetInfo.priority = 0;
+    if (!CheckXrResult(xrCreateActionSet(instance, &actionSetInfo, &actionSet), "xrCreateActionSet")) {
+        return false;
+    }
+
+    xrStringToPath(instance, "/user/hand/left", &handPaths[kHandLeft]);
+    xrStringToPath(instance, "/user/hand/right", &handPaths[kHandRight]);
+
+    bool actionsCreated =
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_FLOAT_INPUT, "trigger", "Gatillo", &triggerAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_FLOAT_INPUT, "squeeze", "Grip", &squeezeAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_VECTOR2F_INPUT, "thumbstick", "Joystick", &thumbstickAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_BOOLEAN_INPUT, "primary", "Botón primario", &primaryAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_BOOLEAN_INPUT, "secondary", "Botón secundario", &secondaryAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_BOOLEAN_INPUT, "thumbstick_click", "Click joystick", &thumbstickClickAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_BOOLEAN_INPUT, "menu", "Menú", &menuAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_POSE_INPUT, "grip_pose", "Pose de agarre", &gripPoseAction) &&
+            createAction(actionSet, handPaths, XR_ACTION_TYPE_POSE_INPUT, "aim_pose", "Pose de apuntado", &aimPoseAction);
+    if (!actionsCreated) {
+        destroy();
+        return false;
+    }
+
+    // Bindings sugeridos: Touch (Quest) y el perfil simple de Khronos como respaldo
+    BindingList touch{instance, {}};
+    for (const char* hand : {"left", "right"}) {
+        std::string prefix = std::string("/user/hand/") + hand;
+        touch.add(triggerAction, (prefix + "/input/trigger/value").c_str());
+        touch.add(squeezeAction, (prefix + "/input/squeeze/value").c_str());
+        touch.add(thumbstickAction, (prefix + "/input/thumbstick").c_str());
+        touch.add(thumbstickClickAction, (prefix + "/input/thumbstick/click").c_str());
+        touch.add(gripPoseAction, (prefix + "/input/grip/pose").c_str());
+        touch.add(aimPoseAction, (prefix + "/input/aim/pose").c_str());
+    }
+    touch.add(primaryAction, "/user/hand/left/input/x/click");
+    touch.add(secondaryAction, "/user/hand/left/input/y/click");
+    touch.add(menuAction, "/user/hand/left/input/menu/click");
+    touch.add(primaryAction, "/user/hand/right/input/a/click");
+    touch.add(secondaryAction, "/user/hand/right/input/b/click");
+    bool anyProfile = touch.suggest("/interaction_profiles/oculus/touch_controller");
+
+    BindingList simple{instance, {}};
+    for (const char* hand : {"left", "right"}) {
+        std::string prefix = std::string("/user/hand/") + hand;
+        simple.add(triggerAction, (prefix + "/input/select/click").c_str());
+        simple.add(menuAction, (prefix + "/input/menu/click").c_str());
+        simple.add(gripPoseAction, (prefix + "/input/grip/pose").c_str());
+        simple.add(aimPoseAction, (prefix + "/input/aim/pose").c_str());
+    }
+    anyProfile = simple.suggest("/interaction_profiles/khr/simple_controller") || anyProfile;
+
+    if (!anyProfile) {
+        LOGE("Ningún perfil de interacción aceptado");
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+bool XrInput::attachSession(XrSession session) {
+    if (actionSet == XR_NULL_HANDLE) {
+        return false;
+    }
+
+    // Espacios de las poses de cada mano
+    for (uint32_t hand = 0; hand < kHandCount; hand++) {
+        XrActionSpaceCreateInfo spaceInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+        spaceInfo.subactionPath = handPaths[hand];
+        spaceInfo.poseInActionSpace = {{0, 0, 0, 1}, {0, 0, 0}};
+
+        spaceInfo.action = gripPoseAction;
+        CheckXrResult(xrCreateActionSpace(session, &spaceInfo, &gripSpaces[hand]), "xrCreateActionSpace (grip)");
+        spaceInfo.action = aimPoseAction;
+        CheckXrResult(xrCreateActionSpace(session, &spaceInfo, &aimSpaces[hand]), "xrCreateActionSpace (aim)");
+    }
+
+    XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+    attachInfo.countActionSets = 1;
+    attachInfo.actionSets = &actionSet;
+    if (!CheckXrResult(xrAttachSessionActionSets(session, &attachInfo), "xrAttachSessionActionSets")) {
+        detachSession();
+        return false;
+    }
+
+    sessionAttached = true;
+    snapshot = InputSnapshot{};
+    LOGI("✓ Sistema de input listo");
+    return true;
+}
+
+void XrInput::detachSession() {
+    for (uint32_t hand = 0; hand < kHandCount; hand++) {
+        if (gripSpaces[hand] != XR_NULL_HANDLE) {
+            xrDestroySpace(gripSpaces[hand]);
+            gripSpaces[hand] = XR_NULL_HANDLE;
+        }
+        if (aimSpaces[hand] != XR_NULL_HANDLE) {
+            xrDestroySpace(aimSpaces[hand]);
+            aimSpaces[hand] = XR_NULL_HANDLE;
+        }
+    }
+    sessionAttached = false;
+    snapshot = InputSnapshot{};
+}
+
+void XrInput::destroy() {
+    detachSession();
+    // Destruir el action set destruye también sus acciones
+    if (actionSet != XR_NULL_HANDLE) {
+        xrDestroyActionSet(actionSet);
+        actionSet = XR_NULL_HANDLE;
+    }
+    triggerAction = squeezeAction = thumbstickAction = XR_NULL_HANDLE;
+    primaryAction = secondaryAction = thumbstickClickAction = menuAction = XR_NULL_HANDLE;
+    gripPoseAction = aimPoseAction = XR_NULL_HANDLE;
+}
+
+bool XrInput::sync(XrSession session, XrTime predictedDisplayTime) {
+    if (!sessionAttached) {
+        return false;
+    }
+
+    XrActiveActionSet activeSet{actionSet, XR_NULL_PATH};
+    XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+    syncInfo.countActiveActionSets = 1;
+    syncInfo.activeActionSets = &activeSet;
+    XrResult result = xrSyncActions(session, &syncInfo);
+    if (XR_FAILED(result)) {
+        CheckXrResult(result, "xrSyncActions");
+        return false;
+    }
+
+    InputSnapshot next;
+    next.sampleTime = predictedDisplayTime;
+
+    // Sin foco el runtime no entrega input: snapshot vacío, pero conservando los flancos de soltado
+    if (result != XR_SESSION_NOT_FOCUSED) {
+        for (uint32_t hand = 0; hand < kHandCount; hand++) {
+            const XrPath subaction = handPaths[hand];
+            bool active = false;
+
+            next.trigger[hand] = readFloat(session, triggerAction, subaction, active);
+            next.squeeze[hand] = readFloat(session, squeezeAction, subaction, active);
+
+            XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            getInfo.action = thumbstickAction;
+            getInfo.subactionPath = subaction;
+            XrActionStateVector2f stick{XR_TYPE_ACTION_STATE_VECTOR2F};
+            if (XR_SUCCEEDED(xrGetActionStateVector2f(session, &getInfo, &stick)) && stick.isActive) {
+                next.thumbstickX[hand] = stick.currentState.x;
+                next.thumbstickY[hand] = stick.currentState.y;
+                active = true;
+            }
+
+            uint32_t buttons = 0;
+            if (readBoolean(session, primaryAction, subaction)) buttons |= kButtonPrimary;
+            if (readBoolean(session, secondaryAction, subaction)) buttons |= kButtonSecondary;
+            if (readBoolean(session, thumbstickClickAction, subaction)) buttons |= kButtonThumbstick;
+            if (readBoolean(session, menuAction, subaction)) buttons |= kButtonMenu;
+            if (next.trigger[hand] > kAnalogButtonThreshold) buttons |= kButtonTrigger;
+            if (next.squeeze[hand] > kAnalogButtonThreshold) buttons |= kButtonSqueeze;
+
+            next.buttonsDown[hand] = buttons;
+            if (active) {
+                next.activeHands |= 1u << hand;
+            }
+        }
+    }
+
+    for (uint32_t hand = 0; hand < kHandCount; hand++) {
+        next.buttonsPressed[hand] = next.buttonsDown[hand] & ~snapshot.buttonsDown[hand];
+        next.buttonsReleased[hand] = snapshot.buttonsDown[hand] & ~next.buttonsDown[hand];
+    }
+
+    snapshot = next;
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cstdint>
+
+enum InputHand : uint32_t {
+    kHandLeft = 0,
+    kHandRight = 1,
+    kHandCount = 2
+};
+
+// Botones digitales por mano (bits de InputSnapshot::buttons*)
+enum InputButtonBits : uint32_t {
+    kButtonPrimary    = 1u << 0,   // A / X
+    kButtonSecondary  = 1u << 1,   // B / Y
+    kButtonThumbstick = 1u << 2,
+    kButtonMenu       = 1u << 3,
+    kButtonTrigger    = 1u << 4,   // trigger por encima del umbral
+    kButtonSqueeze    = 1u << 5,   // grip por encima del umbral
+};
+
+// Estado de input de un frame, escrito una sola vez tras xrSyncActions.
+// Layout plano (arrays por mano) para que el código de juego lo lea sin llamar al runtime.
+struct InputSnapshot {
+    XrTime sampleTime = 0;
+    uint32_t activeHands = 0;                 // Bit (1 << hand) si el controlador está activo
+    float trigger[kHandCount] = {};
+    float squeeze[kHandCount] = {};
+    float thumbstickX[kHandCount] = {};
+    float thumbstickY[kHandCount] = {};
+    uint32_t buttonsDown[kHandCount] = {};
+    uint32_t buttonsPressed[kHandCount] = {}; // Flancos de subida en este frame
+    uint32_t buttonsReleased[kHandCount] = {};
+
+    bool isDown(InputHand hand, uint32_t button) const { return (buttonsDown[hand] & button) != 0; }
+    bool wasPressed(InputHand hand, uint32_t button) const { return (buttonsPressed[hand] & button) != 0; }
+};
+
+// Sistema de acciones OpenXR para los controladores
+struct XrInput {
+    XrActionSet actionSet = XR_NULL_HANDLE;
+    XrAction triggerAction = XR_NULL_HANDLE;
+    XrAction squeezeAction = XR_NULL_HANDLE;
+    XrAction thumbstickAction = XR_NULL_HANDLE;
+    XrAction primaryAction = XR_NULL_HANDLE;
+    XrAction secondaryAction = XR_NULL_HANDLE;
+    XrAction thumbstickClickAction = XR_NULL_HANDLE;
+    XrAction menuAction = XR_NULL_HANDLE;
+    XrAction gripPoseAction = XR_NULL_HANDLE;
+    XrAction aimPoseAction = XR_NULL_HANDLE;
+
+    XrPath handPaths[kHandCount] = {XR_NULL_PATH, XR_NULL_PATH};
+    XrSpace gripSpaces[kHandCount] = {XR_NULL_HANDLE, XR_NULL_HANDLE};
+    XrSpace aimSpaces[kHandCount] = {XR_NULL_HANDLE, XR_NULL_HANDLE};
+
+    bool sessionAttached = false;
+
+    InputSnapshot snapshot;
+
+    // Acciones y bindings sugeridos, una vez por instancia: tras el primer attach
+    // el runtime rechaza nuevas sugerencias (XR_ERROR_ACTIONSETS_ALREADY_ATTACHED)
+    bool initializeInstance(XrInstance instance);
+    // Espacios de las poses y attach del action set a cada sesión nueva
+    bool attachSession(XrSession session);
+    void detachSession();
+    // Todo, antes de destruir la instancia
+    void destroy();
+
+    // Un único xrSyncActions por frame; rellena snapshot
+    bool sync(XrSession session, XrTime predictedDisplayTime);
+};
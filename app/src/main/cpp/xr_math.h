@@ -0,0 +1,97 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cmath>
+
+// Matriz 4x4 en orden column-major (convención de OpenGL / std140)
+struct Mat4 {
+    float m[16];
+};
+
+inline Mat4 mat4Identity() {
+    Mat4 r{};
+    r.m[0] = r.m[5] = r.m[10] = r.m[15] = 1.0f;
+    return r;
+}
+
+inline Mat4 mat4Multiply(const Mat4& a, const Mat4& b) {
+    Mat4 r{};
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            r.m[col * 4 + row] = a.m[0 * 4 + row] * b.m[col * 4 + 0] +
+                                 a.m[1 * 4 + row] * b.m[col * 4 + 1] +
+                                 a.m[2 * 4 + row] * b.m[col * 4 + 2] +
+                                 a.m[3 * 4 + row] * b.m[col * 4 + 3];
+        }
+    }
+    return r;
+}
+
+inline Mat4 mat4Translation(float x, float y, float z) {
+    Mat4 r = mat4Identity();
+    r.m[12] = x;
+    r.m[13] = y;
+    r.m[14] = z;
+    return r;
+}
+
+// Transformación rígida (rotación + traslación) a partir de una pose OpenXR
+inline Mat4 mat4FromPose(const XrPosef& pose) {
+    const float x = pose.orientation.x, y = pose.orientation.y;
+    const float z = pose.orientation.z, w = pose.orientation.w;
+
+    Mat4 r{};
+    r.m[0] = 1.0f - 2.0f * (y * y + z * z);
+    r.m[1] = 2.0f * (x * y + w * z);
+    r.m[2] = 2.0f * (x * z - w * y);
+    r.m[4] = 2.0f * (x * y - w * z);
+    r.m[5] = 1.0f - 2.0f * (x * x + z * z);
+    r.m[6] = 2.0f * (y * z + w * x);
+    r.m[8] = 2.0f * (x * z + w * y);
+    r.m[9] = 2.0f * (y * z - w * x);
+    r.m[10] = 1.0f - 2.0f * (x * x + y * y);
+    r.m[12] = pose.position.x;
+    r.m[13] = pose.position.y;
+    r.m[14] = pose.position.z;
+    r.m[15] = 1.0f;
+    return r;
+}
+
+// Inversa de una transformación rígida: R^T y -R^T * t
+inline Mat4 mat4InvertRigid(const Mat4& m) {
+    Mat4 r{};
+    r.m[0] = m.m[0]; r.m[1] = m.m[4]; r.m[2] = m.m[8];
+    r.m[4] = m.m[1]; r.m[5] = m.m[5]; r.m[6] = m.m[9];
+    r.m[8] = m.m[2]; r.m[9] = m.m[6]; r.m[10] = m.m[10];
+    r.m[12] = -(m.m[0] * m.m[12] + m.m[1] * m.m[13] + m.m[2] * m.m[14]);
+    r.m[13] = -(m.m[4] * m.m[12] + m.m[5] * m.m[13] + m.m[6] * m.m[14]);
+    r.m[14] = -(m.m[8] * m.m[12] + m.m[9] * m.m[13] + m.m[10] * m.m[14]);
+    r.m[15] = 1.0f;
+    return r;
+}
+
+// Proyección asimétrica a partir del FOV de OpenXR (rango de profundidad de OpenGL ES, -1..1)
+inline Mat4 mat4ProjectionFov(const XrFovf& fov, float nearZ, float farZ) {
+    const float tanLeft = std::tan(fov.angleLeft);
+    const float tanRight = std::tan(fov.angleRight);
+    const float tanDown = std::tan(fov.angleDown);
+    const float tanUp = std::tan(fov.angleUp);
+    const float tanWidth = tanRight - tanLeft;
+    const float tanHeight = tanUp - tanDown;
+
+    Mat4 r{};
+    r.m[0] = 2.0f / tanWidth;
+    r.m[5] = 2.0f / tanHeight;
+    r.m[8] = (tanRight + tanLeft) / tanWidth;
+    r.m[9] = (tanUp + tanDown) / tanHeight;
+    r.m[10] = -(farZ + nearZ) / (farZ - nearZ);
+    r.m[11] = -1.0f;
+    r.m[14] = -(2.0f * farZ * nearZ) / (farZ - nearZ);
+    return r;
+}
+
+// Matriz vista-proyección de un ojo
+inline Mat4 mat4ViewProjection(const XrView& view, float nearZ, float farZ) {
+    Mat4 viewMatrix = mat4InvertRigid(mat4FromPose(view.pose));
+    return mat4Multiply(mat4ProjectionFov(view.fov, nearZ, farZ), viewMatrix);
+}
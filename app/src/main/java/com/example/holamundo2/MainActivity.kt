@@ -1,6 +1,8 @@
 package com.example.holamundo2
 
 import android.app.Activity
+import android.content.pm.PackageManager
+import android.content.res.AssetManager
 import android.opengl.GLSurfaceView
 import android.os.Bundle
 import android.util.Log
@@ -15,6 +17,30 @@ class MainActivity : Activity() {
     companion object {
         const val TAG = "OpenXRHolaMundo"
 
+        // Modos de foveation (deben coincidir con FoveationMode en foveation.h)
+        const val FOVEATION_FIXED = 1
+        const val FOVEATION_EYE_TRACKED = 2
+
+        private const val EYE_TRACKING_PERMISSION = "com.oculus.permission.EYE_TRACKING"
+        private const val EYE_TRACKING_REQUEST_CODE = 1
+
+        // Realidad mixta: adb shell am start -n .../.MainActivity --ez passthrough true
+        private const val EXTRA_PASSTHROUGH = "passthrough"
+
+        // Benchmarks: --ez pin_threads true fija afinidad y nice de los hilos por papel
+        private const val EXTRA_PIN_THREADS = "pin_threads"
+
+        // Benchmark del job system: --ez bench_jobs true (en segundo plano al arrancar)
+        private const val EXTRA_BENCH_JOBS = "bench_jobs"
+        // Benchmark de draw packets: --ez bench_draws true (en segundo plano al arrancar)
+        private const val EXTRA_BENCH_DRAWS = "bench_draws"
+        // Benchmark de la cola de render: --ez bench_sort true (en segundo plano al arrancar)
+        private const val EXTRA_BENCH_SORT = "bench_sort"
+
+        // Prueba de recuperación: --es inject_xr_loss session|instance (a los 5 s de arrancar)
+        private const val EXTRA_INJECT_XR_LOSS = "inject_xr_loss"
+        private const val INJECT_XR_LOSS_DELAY_MS = 5000L
+
         init {
             try {
                 Log.d(TAG, "Intentando cargar librería nativa...")
@@ -31,6 +57,16 @@ class MainActivity : Activity() {
     }
 
     // Declaraciones de funciones nativas
+    private external fun nativeSetAssetManager(assetManager: AssetManager)
+    private external fun nativeSetLateLatching(enabled: Boolean)
+    private external fun nativeSetFoveationMode(mode: Int)
+    private external fun nativeSetPassthrough(enabled: Boolean)
+    private external fun nativeGetLatencyHistograms(): LongArray
+    private external fun nativeInjectXrLoss(instanceLoss: Boolean)
+    private external fun nativeSetThreadPinning(enabled: Boolean)
+    private external fun nativeRunJobBenchmark()
+    private external fun nativeRunDrawBenchmark()
+    private external fun nativeRunSortBenchmark()
     private external fun nativeInitialize(): Boolean
     private external fun nativeSetupEGL(surface: Surface): Boolean
     private external fun nativeCreateSession(): Boolean
@@ -52,6 +88,24 @@ class MainActivity : Activity() {
             Log.d(TAG, "Configurando ventana VR...")
             setupVRWindow()
 
+            Log.d(TAG, "Configurando AssetManager nativo...")
+            nativeSetAssetManager(assets)
+            nativeSetLateLatching(true)
+
+            Log.d(TAG, "Configurando foveation...")
+            setupFoveation()
+            nativeSetPassthrough(intent.getBooleanExtra(EXTRA_PASSTHROUGH, false))
+            nativeSetThreadPinning(intent.getBooleanExtra(EXTRA_PIN_THREADS, false))
+            if (intent.getBooleanExtra(EXTRA_BENCH_JOBS, false)) {
+                activityScope.launch(Dispatchers.Default) { nativeRunJobBenchmark() }
+            }
+            if (intent.getBooleanExtra(EXTRA_BENCH_DRAWS, false)) {
+                activityScope.launch(Dispatchers.Default) { nativeRunDrawBenchmark() }
+            }
+            if (intent.getBooleanExtra(EXTRA_BENCH_SORT, false)) {
+                activityScope.launch(Dispatchers.Default) { nativeRunSortBenchmark() }
+            }
+
             Log.d(TAG, "Configurando GLSurfaceView...")
             setupGLSurfaceView()
 
@@ -62,6 +116,25 @@ class MainActivity : Activity() {
         }
     }
 
+    // Foveation eye-tracked si hay permiso de eye tracking; si no, fija
+    private fun setupFoveation() {
+        if (checkSelfPermission(EYE_TRACKING_PERMISSION) == PackageManager.PERMISSION_GRANTED) {
+            nativeSetFoveationMode(FOVEATION_EYE_TRACKED)
+        } else {
+            nativeSetFoveationMode(FOVEATION_FIXED)
+            requestPermissions(arrayOf(EYE_TRACKING_PERMISSION), EYE_TRACKING_REQUEST_CODE)
+        }
+    }
+
+    override fun onRequestPermissionsResult(requestCode: Int, permissions: Array<out String>, grantResults: IntArray) {
+        super.onRequestPermissionsResult(requestCode, permissions, grantResults)
+        if (requestCode == EYE_TRACKING_REQUEST_CODE) {
+            val granted = grantResults.isNotEmpty() && grantResults[0] == PackageManager.PERMISSION_GRANTED
+            Log.d(TAG, "Permiso de eye tracking ${if (granted) "concedido" else "denegado"}")
+            nativeSetFoveationMode(if (granted) FOVEATION_EYE_TRACKED else FOVEATION_FIXED)
+        }
+    }
+
     private fun setupVRWindow() {
         Log.d(TAG, "Configurando flags de ventana...")
         window.addFlags(WindowManager.LayoutParams.FLAG_KEEP_SCREEN_ON)
@@ -85,8 +158,13 @@ class MainActivity : Activity() {
             Log.d(TAG, "Configurando versión de contexto OpenGL ES...")
             setEGLContextClientVersion(3)
 
+            // OpenXR renderiza con un contexto nativo propio (ver nativeSetupEGL);
+            // la superficie de GLSurfaceView no se presenta, así que basta con la config mínima
             Log.d(TAG, "Configurando selector de configuración EGL...")
-            setEGLConfigChooser(8, 8, 8, 8, 24, 8)
+            setEGLConfigChooser(8, 8, 8, 0, 0, 0)
+
+            // Conservar el contexto al pausar; el nativo sobrevive de todos modos (reanudación en caliente)
+            preserveEGLContextOnPause = true
 
             setRenderer(object : GLSurfaceView.Renderer {
                 override fun onSurfaceCreated(gl: GL10?, config: EGLConfig?) {
@@ -140,6 +218,8 @@ class MainActivity : Activity() {
 
                 override fun surfaceDestroyed(holder: android.view.SurfaceHolder) {
                     Log.d(TAG, "surfaceDestroyed() - SurfaceHolder destruido")
+                    // Al volver se repite initializeOpenXRInGLThread: con la instancia y el
+                    // contexto nativo vivos, las tres llamadas toman el camino en caliente
                     surfaceReady = false
                     isRunning = false
                     openxrInitialized = false
@@ -161,7 +241,8 @@ class MainActivity : Activity() {
         Log.d(TAG, "Hilo actual: ${Thread.currentThread().name}")
 
         try {
-            // 1. Inicializar OpenXR (puede ejecutarse en cualquier hilo)
+            // 1. Inicializar OpenXR: carga el loader y lanza el descubrimiento de
+            //    instancia/sistema en segundo plano mientras se configura EGL
             Log.d(TAG, "Paso 1/3: Llamando a nativeInitialize()...")
             if (!nativeInitialize()) {
                 Log.e(TAG, "nativeInitialize() falló")
@@ -205,6 +286,7 @@ class MainActivity : Activity() {
 
             runOnUiThread {
                 Log.i(TAG, "🎉 OpenXR completamente inicializado y listo para renderizar!")
+                scheduleInjectedXrLoss()
             }
 
         } catch (e: Exception) {
@@ -216,6 +298,17 @@ class MainActivity : Activity() {
         }
     }
 
+    // Simula la pérdida de sesión o instancia para probar la recuperación automática
+    private fun scheduleInjectedXrLoss() {
+        val kind = intent.getStringExtra(EXTRA_INJECT_XR_LOSS) ?: return
+        intent.removeExtra(EXTRA_INJECT_XR_LOSS)
+        activityScope.launch {
+            delay(INJECT_XR_LOSS_DELAY_MS)
+            Log.w(TAG, "Inyectando pérdida OpenXR: $kind")
+            nativeInjectXrLoss(kind == "instance")
+        }
+    }
+
     override fun onResume() {
         super.onResume()
         Log.d(TAG, "onResume() - Reanudando actividad")
@@ -236,6 +329,43 @@ class MainActivity : Activity() {
         isRunning = false
         glSurfaceView?.onPause()
         Log.d(TAG, "GLSurfaceView pausado")
+
+        if (openxrInitialized) {
+            logLatencyHistograms()
+        }
+    }
+
+    // Resumen de los histogramas de latencia nativos (formato en LatencyTracker::exportHistograms)
+    private fun logLatencyHistograms() {
+        val data = nativeGetLatencyHistograms()
+        if (data.size < 3) return
+        val stageCount = data[0].toInt()
+        val bucketCount = data[1].toInt()
+        val bucketWidthNs = data[2]
+        val stageNames = arrayOf("input", "pose", "submit")
+        var offset = 3
+        for (stage in 0 until stageCount) {
+            val count = data[offset]
+            val sumNs = data[offset + 1]
+            val maxNs = data[offset + 2]
+            val buckets = data.copyOfRange(offset + 3, offset + 3 + bucketCount)
+            offset += 3 + bucketCount
+            if (count == 0L) continue
+
+            // Percentil 99 aproximado a partir de las cubetas
+            var accumulated = 0L
+            var p99Bucket = bucketCount - 1
+            for (i in buckets.indices) {
+                accumulated += buckets[i]
+                if (accumulated * 100 >= count * 99) {
+                    p99Bucket = i
+                    break
+                }
+            }
+            val name = stageNames.getOrElse(stage) { "etapa $stage" }
+            Log.i(TAG, "Latencia $name->photon: media %.2f ms, p99 <%.1f ms, máx %.2f ms (%d frames)".format(
+                sumNs / count / 1e6, (p99Bucket + 1) * bucketWidthNs / 1e6, maxNs / 1e6, count))
+        }
     }
 
     override fun onDestroy() {
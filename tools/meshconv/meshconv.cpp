@@ -0,0 +1,351 @@
+// meshconv: convierte mallas Wavefront OBJ al formato binario .hmesh de la app
+// (ver app/src/main/cpp/mesh_format.h) y mide el tiempo de carga frente a un
+// parseo directo del OBJ.
+//
+// Compilación en el host:
+//   g++ -std=c++17 -O2 -I app/src/main/cpp tools/meshconv/meshconv.cpp -o meshconv
+//
+// Uso:
+//   meshconv entrada.obj salida.hmesh
+//   meshconv --bench entrada.obj malla.hmesh [iteraciones]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mesh_format.h"
+
+namespace {
+
+struct ObjMesh {
+    std::string name;
+    uint32_t attributes = kMeshAttribPosition;
+    std::vector<float> vertices;     // Entrelazados según attributes
+    std::vector<uint32_t> indices;
+};
+
+struct ObjVertexKey {
+    int position, texCoord, normal;
+    bool operator==(const ObjVertexKey& other) const {
+        return position == other.position && texCoord == other.texCoord && normal == other.normal;
+    }
+};
+
+struct ObjVertexKeyHash {
+    size_t operator()(const ObjVertexKey& key) const {
+        return (static_cast<size_t>(key.position) * 73856093u) ^
+               (static_cast<size_t>(key.texCoord) * 19349663u) ^
+               (static_cast<size_t>(key.normal) * 83492791u);
+    }
+};
+
+// Índice OBJ (1-based, negativos relativos al final) a índice 0-based; -1 si falta
+int resolveObjIndex(const std::string& token, size_t count) {
+    if (token.empty()) {
+        return -1;
+    }
+    int index = std::atoi(token.c_str());
+    if (index < 0) {
+        return static_cast<int>(count) + index;
+    }
+    return index - 1;
+}
+
+// Parseo completo del OBJ: es también la referencia "naive" del benchmark
+bool parseObj(const char* path, std::vector<ObjMesh>& meshes) {
+    std::ifstream input(path);
+    if (!input) {
+        fprintf(stderr, "No se pudo abrir %s\n", path);
+        return false;
+    }
+
+    std::vector<float> positions, texCoords, normals;
+    std::unordered_map<ObjVertexKey, uint32_t, ObjVertexKeyHash> vertexCache;
+    meshes.clear();
+    meshes.emplace_back();
+    meshes.back().name = "mesh";
+
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream stream(line);
+        std::string tag;
+        stream >> tag;
+
+        if (tag == "v") {
+            float x, y, z;
+            stream >> x >> y >> z;
+            positions.insert(positions.end(), {x, y, z});
+        } else if (tag == "vt") {
+            float u, v;
+            stream >> u >> v;
+            texCoords.insert(texCoords.end(), {u, v});
+        } else if (tag == "vn") {
+            float x, y, z;
+            stream >> x >> y >> z;
+            normals.insert(normals.end(), {x, y, z});
+        } else if (tag == "o" || tag == "g") {
+            std::string name;
+            stream >> name;
+            if (!meshes.back().indices.empty()) {
+                meshes.push_back(ObjMesh{});
+                vertexCache.clear();
+            }
+            meshes.back().name = name;
+        } else if (tag == "f") {
+            ObjMesh& mesh = meshes.back();
+            std::vector<uint32_t> polygon;
+            std::string corner;
+            while (stream >> corner) {
+                std::string parts[3];
+                size_t part = 0;
+                for (char c : corner) {
+                    if (c == '/') {
+                        if (++part > 2) break;
+                    } else {
+                        parts[part] += c;
+                    }
+                }
+
+                ObjVertexKey key{resolveObjIndex(parts[0], positions.size() / 3),
+                                 resolveObjIndex(parts[1], texCoords.size() / 2),
+                                 resolveObjIndex(parts[2], normals.size() / 3)};
+                if (key.position < 0 || static_cast<size_t>(key.position) * 3 >= positions.size()) {
+                    fprintf(stderr, "Índice de posición inválido en: %s\n", line.c_str());
+                    return false;
+                }
+                if (key.normal >= 0) mesh.attributes |= kMeshAttribNormal;
+                if (key.texCoord >= 0) mesh.attributes |= kMeshAttribTexCoord;
+
+                auto cached = vertexCache.find(key);
+                if (cached != vertexCache.end()) {
+                    polygon.push_back(cached->second);
+                    continue;
+                }
+
+                // Se guardan los 8 floats siempre; el layout final se compacta al escribir
+                uint32_t newIndex = static_cast<uint32_t>(mesh.vertices.size() / 8);
+                const float* p = &positions[key.position * 3];
+                mesh.vertices.insert(mesh.vertices.end(), {p[0], p[1], p[2]});
+                if (key.normal >= 0 && static_cast<size_t>(key.normal) * 3 < normals.size()) {
+                    const float* n = &normals[key.normal * 3];
+                    mesh.vertices.insert(mesh.vertices.end(), {n[0], n[1], n[2]});
+                } else {
+                    mesh.vertices.insert(mesh.vertices.end(), {0.0f, 0.0f, 1.0f});
+                }
+                if (key.texCoord >= 0 && static_cast<size_t>(key.texCoord) * 2 < texCoords.size()) {
+                    const float* t = &texCoords[key.texCoord * 2];
+                    mesh.vertices.insert(mesh.vertices.end(), {t[0], t[1]});
+                } else {
+                    mesh.vertices.insert(mesh.vertices.end(), {0.0f, 0.0f});
+                }
+                vertexCache.emplace(key, newIndex);
+                polygon.push_back(newIndex);
+            }
+
+            // Triangulación en abanico
+            for (size_t i = 2; i < polygon.size(); i++) {
+                mesh.indices.insert(mesh.indices.end(), {polygon[0], polygon[i - 1], polygon[i]});
+            }
+        }
+    }
+
+    // Descartar mallas vacías (p. ej. la inicial si el OBJ empieza con "o")
+    std::vector<ObjMesh> nonEmpty;
+    for (auto& mesh : meshes) {
+        if (!mesh.indices.empty()) {
+            nonEmpty.push_back(std::move(mesh));
+        }
+    }
+    meshes.swap(nonEmpty);
+    return !meshes.empty();
+}
+
+uint64_t alignUp(uint64_t value) {
+    return (value + kMeshBlobAlignment - 1) / kMeshBlobAlignment * kMeshBlobAlignment;
+}
+
+bool writeHmesh(const char* path, const std::vector<ObjMesh>& meshes) {
+    MeshFileHeader header{kMeshFileMagic, kMeshFileVersion, static_cast<uint32_t>(meshes.size()), 0};
+    std::vector<MeshRecord> records(meshes.size());
+    std::vector<std::vector<uint8_t>> vertexBlobs(meshes.size());
+    std::vector<std::vector<uint8_t>> indexBlobs(meshes.size());
+
+    uint64_t cursor = alignUp(sizeof(MeshFileHeader) + meshes.size() * sizeof(MeshRecord));
+    for (size_t m = 0; m < meshes.size(); m++) {
+        const ObjMesh& mesh = meshes[m];
+        MeshRecord& record = records[m];
+        memset(&record, 0, sizeof(record));
+        strncpy(record.name, mesh.name.c_str(), kMeshNameSize - 1);
+
+        const size_t vertexCount = mesh.vertices.size() / 8;
+        record.attributes = mesh.attributes;
+        record.vertexStride = meshVertexStride(mesh.attributes);
+        record.vertexCount = static_cast<uint32_t>(vertexCount);
+        record.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        record.indexSize = vertexCount <= 0xFFFF ? 2 : 4;
+
+        // Compactar los vértices al layout declarado
+        std::vector<uint8_t>& vertexBlob = vertexBlobs[m];
+        vertexBlob.reserve(vertexCount * record.vertexStride);
+        for (size_t v = 0; v < vertexCount; v++) {
+            const float* src = &mesh.vertices[v * 8];
+            auto append = [&vertexBlob](const float* values, size_t count) {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+                vertexBlob.insert(vertexBlob.end(), bytes, bytes + count * sizeof(float));
+            };
+            append(src, 3);
+            if (mesh.attributes & kMeshAttribNormal) append(src + 3, 3);
+            if (mesh.attributes & kMeshAttribTexCoord) append(src + 6, 2);
+        }
+
+        std::vector<uint8_t>& indexBlob = indexBlobs[m];
+        for (uint32_t index : mesh.indices) {
+            if (record.indexSize == 2) {
+                uint16_t shortIndex = static_cast<uint16_t>(index);
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&shortIndex);
+                indexBlob.insert(indexBlob.end(), bytes, bytes + 2);
+            } else {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&index);
+                indexBlob.insert(indexBlob.end(), bytes, bytes + 4);
+            }
+        }
+
+        record.vertexOffset = cursor;
+        record.vertexBytes = vertexBlob.size();
+        cursor = alignUp(cursor + record.vertexBytes);
+        record.indexOffset = cursor;
+        record.indexBytes = indexBlob.size();
+        cursor = alignUp(cursor + record.indexBytes);
+    }
+
+    std::vector<uint8_t> output(cursor, 0);
+    memcpy(output.data(), &header, sizeof(header));
+    memcpy(output.data() + sizeof(header), records.data(), records.size() * sizeof(MeshRecord));
+    for (size_t m = 0; m < meshes.size(); m++) {
+        memcpy(output.data() + records[m].vertexOffset, vertexBlobs[m].data(), vertexBlobs[m].size());
+        memcpy(output.data() + records[m].indexOffset, indexBlobs[m].data(), indexBlobs[m].size());
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "No se pudo escribir %s\n", path);
+        return false;
+    }
+    bool ok = fwrite(output.data(), 1, output.size(), file) == output.size();
+    fclose(file);
+
+    for (const auto& record : records) {
+        printf("  %-20s %6u vértices (stride %u), %7u índices (%u bytes)\n",
+               record.name, record.vertexCount, record.vertexStride, record.indexCount, record.indexSize);
+    }
+    printf("%s: %zu mallas, %zu bytes\n", path, meshes.size(), output.size());
+    return ok;
+}
+
+// Suma de todos los bytes de un blob: lee el mismo volumen que copiaría glBufferData
+uint64_t checksumBlob(const uint8_t* data, uint64_t bytes) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < bytes; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+// Misma validación que hace la app (mesh_format.h) y lectura completa de los blobs
+bool mapAndValidateHmesh(const char* path, uint64_t& checksum) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(MeshFileHeader)) {
+        close(fd);
+        return false;
+    }
+    const uint64_t fileSize = static_cast<uint64_t>(info.st_size);
+    void* base = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(base);
+    MeshFileHeader header;
+    memcpy(&header, data, sizeof(header));
+    bool ok = header.magic == kMeshFileMagic && header.version == kMeshFileVersion &&
+              meshTableInFile(header, fileSize);
+    for (uint32_t i = 0; ok && i < header.meshCount; i++) {
+        MeshRecord record;
+        memcpy(&record, data + sizeof(header) + i * sizeof(MeshRecord), sizeof(record));
+        if (const char* error = validateMeshRecord(record, fileSize)) {
+            fprintf(stderr, "Malla %u de %s inválida: %s\n", i, path, error);
+            ok = false;
+            break;
+        }
+        checksum += checksumBlob(data + record.vertexOffset, record.vertexBytes);
+        if (record.indexCount > 0) {
+            checksum += checksumBlob(data + record.indexOffset, record.indexBytes);
+        }
+    }
+
+    munmap(base, fileSize);
+    return ok;
+}
+
+int runBenchmark(const char* objPath, const char* hmeshPath, int iterations) {
+    using Clock = std::chrono::steady_clock;
+    uint64_t checksum = 0;
+
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        std::vector<ObjMesh> meshes;
+        if (!parseObj(objPath, meshes)) return 1;
+        checksum += meshes.size();
+    }
+    double objMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+
+    start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        if (!mapAndValidateHmesh(hmeshPath, checksum)) {
+            fprintf(stderr, "%s no es un .hmesh válido\n", hmeshPath);
+            return 1;
+        }
+    }
+    double hmeshMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+
+    printf("Parseo OBJ:    %10.4f ms/carga\n", objMs);
+    printf("Lectura .hmesh: %9.4f ms/carga\n", hmeshMs);
+    printf("Aceleración:   %10.1fx  (checksum %llu)\n", objMs / hmeshMs, static_cast<unsigned long long>(checksum));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && strcmp(argv[1], "--bench") == 0) {
+        int iterations = argc >= 5 ? std::atoi(argv[4]) : 100;
+        return runBenchmark(argv[2], argv[3], iterations > 0 ? iterations : 1);
+    }
+    if (argc != 3) {
+        fprintf(stderr, "Uso: %s entrada.obj salida.hmesh\n", argv[0]);
+        fprintf(stderr, "     %s --bench entrada.obj malla.hmesh [iteraciones]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<ObjMesh> meshes;
+    if (!parseObj(argv[1], meshes)) {
+        return 1;
+    }
+    return writeHmesh(argv[2], meshes) ? 0 : 1;
+}